@@ -0,0 +1,217 @@
+//
+//  CompactPointArray.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Map point on the integer grid. Map coordinates never exceed `GLMapPointMax`, so 8 bytes instead of 16.
+struct MapPointI: Equatable {
+    var x: Int32
+    var y: Int32
+
+    init(x: Int32, y: Int32) {
+        self.x = x
+        self.y = y
+    }
+
+    /// Rounds to the nearest grid point (about 2 cm at the equator). X is taken modulo the world width, so a
+    /// point from a neighbouring world copy keeps its meridian; y outside the world is a programming error.
+    init(_ point: GLMapPoint) {
+        let w = Double(GLMapPointMax)
+        var x = point.x.rounded().truncatingRemainder(dividingBy: w)
+        if x < 0 { x += w }
+        let y = point.y.rounded()
+        precondition(y >= 0 && y <= w, "y \(point.y) is outside the world")
+        self.init(x: Int32(x), y: Int32(y))
+    }
+
+    /// Lossless conversion, `nil` if the point is not on the grid.
+    init?(exactly point: GLMapPoint) {
+        guard let x = Int32(exactly: point.x), let y = Int32(exactly: point.y) else { return nil }
+        self.init(x: x, y: y)
+    }
+
+    var mapPoint: GLMapPoint { GLMapPoint(x: Double(x), y: Double(y)) }
+}
+
+/// Point storage for long tracks and lines: `int32` keeps `MapPointI` (8 bytes per point), `delta16` keeps
+/// Int16 deltas to the previous point (4 bytes per point) with an absolute anchor every 64 points for
+/// random access. Deltas that do not fit in Int16 are escaped to a side array.
+struct CompactPointArray {
+    enum Encoding {
+        case int32
+        case delta16
+    }
+
+    private static let blockSize = 64
+    private static let escape = Int16.min
+
+    let encoding: Encoding
+    private(set) var count = 0
+
+    private var points: [MapPointI] = []
+    private var anchors: [MapPointI] = []
+    private var deltas: [Int16] = []
+    private var escapes: [MapPointI] = []
+    private var blockEscapeStart: [Int32] = []
+    private var last = MapPointI(x: 0, y: 0)
+
+    init(encoding: Encoding = .int32) {
+        self.encoding = encoding
+    }
+
+    init<S: Sequence>(_ points: S, encoding: Encoding = .int32) where S.Element == GLMapPoint {
+        self.init(encoding: encoding)
+        reserveCapacity(points.underestimatedCount)
+        for point in points {
+            append(point)
+        }
+    }
+
+    mutating func reserveCapacity(_ n: Int) {
+        switch encoding {
+        case .int32:
+            points.reserveCapacity(n)
+        case .delta16:
+            deltas.reserveCapacity(2 * n)
+            anchors.reserveCapacity(n / CompactPointArray.blockSize + 1)
+        }
+    }
+
+    mutating func append(_ point: GLMapPoint) {
+        append(MapPointI(point))
+    }
+
+    mutating func append(_ p: MapPointI) {
+        switch encoding {
+        case .int32:
+            points.append(p)
+        case .delta16:
+            if count % CompactPointArray.blockSize == 0 {
+                anchors.append(p)
+                blockEscapeStart.append(Int32(escapes.count))
+                deltas.append(0)
+                deltas.append(0)
+            } else {
+                let dx = Int64(p.x) - Int64(last.x), dy = Int64(p.y) - Int64(last.y)
+                if abs(dx) <= Int64(Int16.max) && abs(dy) <= Int64(Int16.max) {
+                    deltas.append(Int16(dx))
+                    deltas.append(Int16(dy))
+                } else {
+                    deltas.append(CompactPointArray.escape)
+                    deltas.append(CompactPointArray.escape)
+                    escapes.append(p)
+                }
+            }
+            last = p
+        }
+        count += 1
+    }
+
+    subscript(index: Int) -> GLMapPoint {
+        return pointI(at: index).mapPoint
+    }
+
+    func pointI(at index: Int) -> MapPointI {
+        precondition(index >= 0 && index < count)
+        switch encoding {
+        case .int32:
+            return points[index]
+        case .delta16:
+            let block = index / CompactPointArray.blockSize
+            var p = anchors[block]
+            var escape = Int(blockEscapeStart[block])
+            var i = block * CompactPointArray.blockSize + 1
+            while i <= index {
+                step(&p, i, &escape)
+                i += 1
+            }
+            return p
+        }
+    }
+
+    /// Sequential decode, O(1) per point in both encodings.
+    func forEach(_ body: (MapPointI) -> Void) {
+        switch encoding {
+        case .int32:
+            points.forEach(body)
+        case .delta16:
+            var p = MapPointI(x: 0, y: 0)
+            var escape = 0
+            for i in 0..<count {
+                if i % CompactPointArray.blockSize == 0 {
+                    p = anchors[i / CompactPointArray.blockSize]
+                } else {
+                    step(&p, i, &escape)
+                }
+                body(p)
+            }
+        }
+    }
+
+    /// Heap bytes used by the point data.
+    var byteCount: Int {
+        switch encoding {
+        case .int32:
+            return points.count * MemoryLayout<MapPointI>.stride
+        case .delta16:
+            return deltas.count * MemoryLayout<Int16>.stride
+                + (anchors.count + escapes.count) * MemoryLayout<MapPointI>.stride
+                + blockEscapeStart.count * MemoryLayout<Int32>.stride
+        }
+    }
+
+    /// Builds a `GLMapPointArray` straight from the compact storage, without an intermediate `[GLMapPoint]`.
+    func makePointArray() -> GLMapPointArray {
+        var cursor = Cursor(self)
+        return GLMapPointArray(count: UInt(count)) { i in cursor.point(at: Int(i)).mapPoint }
+    }
+
+    func makeTrackData(color: GLMapColor) -> GLMapTrackData? {
+        guard count > 0 else { return nil }
+        var cursor = Cursor(self)
+        return GLMapTrackData(pointsCallback: { i, pt in
+            pt.pointee = GLTrackPoint(pt: cursor.point(at: Int(i)).mapPoint, color: color)
+            return true
+        }, count: UInt(count))
+    }
+
+    private func step(_ p: inout MapPointI, _ i: Int, _ escape: inout Int) {
+        let dx = deltas[2 * i], dy = deltas[2 * i + 1]
+        if dx == CompactPointArray.escape && dy == CompactPointArray.escape {
+            p = escapes[escape]
+            escape += 1
+        } else {
+            p.x += Int32(dx)
+            p.y += Int32(dy)
+        }
+    }
+
+    /// Reader for callback-driven framework constructors. They ask for points in order, which decodes in
+    /// O(1) each; any other index falls back to random access.
+    private struct Cursor {
+        let array: CompactPointArray
+        var index = 0
+        var point = MapPointI(x: 0, y: 0)
+        var escape = 0
+
+        init(_ array: CompactPointArray) {
+            self.array = array
+        }
+
+        mutating func point(at i: Int) -> MapPointI {
+            guard array.encoding == .delta16, i == index else { return array.pointI(at: i) }
+            defer { index += 1 }
+            if index % CompactPointArray.blockSize == 0 {
+                point = array.anchors[index / CompactPointArray.blockSize]
+            } else {
+                array.step(&point, index, &escape)
+            }
+            return point
+        }
+    }
+}
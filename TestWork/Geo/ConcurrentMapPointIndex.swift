@@ -0,0 +1,92 @@
+//
+//  ConcurrentMapPointIndex.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// `MapPointIndex` shared between an ingestion thread and readers such as the UI.
+///
+/// The current version is published through an atomic pointer. A reader announces itself in one of two
+/// counters, loads and retains the version and leaves; it never waits for anything. Writers are
+/// serialized, apply their changes to a `copy()` (which shares the trees and duplicates only the pending
+/// list and touched tombstone chunks) and swap it in. The replaced version is released only after both
+/// counters have drained once, so no reader can be between the load and the retain of it (RCU with two
+/// grace-period counters). A snapshot stays valid, and unchanged, for as long as a reader keeps it.
+final class ConcurrentMapPointIndex {
+    /// Retained `MapPointIndex`.
+    private let current: UnsafeMutablePointer<UnsafeMutableRawPointer?>
+    /// Readers in `snapshot()`, by epoch parity.
+    private let readers: UnsafeMutablePointer<Int>
+    private let epoch: UnsafeMutablePointer<Int>
+    private let writeLock = NSLock()
+
+    init(index: MapPointIndex = MapPointIndex()) {
+        current = .allocate(capacity: 1)
+        current.initialize(to: Unmanaged.passRetained(index).toOpaque())
+        readers = .allocate(capacity: 2)
+        readers.initialize(repeating: 0, count: 2)
+        epoch = .allocate(capacity: 1)
+        epoch.initialize(to: 0)
+    }
+
+    deinit {
+        Unmanaged<MapPointIndex>.fromOpaque(current.pointee!).release()
+        current.deallocate()
+        readers.deallocate()
+        epoch.deallocate()
+    }
+
+    /// Current version of the index. Must not be modified. Lock-free.
+    func snapshot() -> MapPointIndex {
+        let slot = readers + (AtomicLoadInt(epoch) & 1)
+        _ = AtomicFetchAddInt(slot, 1)
+        let index = Unmanaged<MapPointIndex>.fromOpaque(AtomicLoadPointer(current)!).retain()
+        _ = AtomicFetchAddInt(slot, -1)
+        return index.takeRetainedValue()
+    }
+
+    /// Applies `body` to a copy of the index and publishes the result. Batch several changes in one call
+    /// when you can, each call waits out one grace period.
+    func update(_ body: (MapPointIndex) -> Void) {
+        writeLock.lock()
+        defer { writeLock.unlock() }
+        // Only writers release versions, so the current one cannot go away under the lock.
+        let next = Unmanaged<MapPointIndex>.fromOpaque(current.pointee!).takeUnretainedValue().copy()
+        body(next)
+        publish(next)
+    }
+
+    /// Replaces the content with a freshly bulk-loaded index, no copy of the old storage is made.
+    func reset(items: [MapPointIndex.Item]) {
+        let next = MapPointIndex(items: items)
+        writeLock.lock()
+        defer { writeLock.unlock() }
+        publish(next)
+    }
+
+    func nearestItems(to point: GLMapPoint, k: Int) -> [MapPointIndex.Item] {
+        return snapshot().nearestItems(to: point, k: k)
+    }
+
+    func forEachItem(within radius: Double, of center: GLMapPoint, _ body: (MapPointIndex.Item) -> Void) {
+        snapshot().forEachItem(within: radius, of: center, body)
+    }
+
+    private func publish(_ index: MapPointIndex) {
+        let old = AtomicExchangePointer(current, Unmanaged.passRetained(index).toOpaque())!
+        // A reader that may still load `old` has registered in one of the counters before the swap.
+        // Flipping the epoch twice and draining the counter left behind each time covers both; readers
+        // arriving meanwhile see the new version and use the other counter.
+        for _ in 0..<2 {
+            let drained = readers + (AtomicFetchAddInt(epoch, 1) & 1)
+            while AtomicLoadInt(drained) != 0 {
+                sched_yield()
+            }
+        }
+        Unmanaged<MapPointIndex>.fromOpaque(old).release()
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  GLMapBBox+Wrap.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Antimeridian-aware bounding box algebra.
+///
+/// A wrapped box keeps `origin.x` in `0..<GLMapPointMax` and may have `origin.x + size.x` past the world edge,
+/// the same convention `GLMapBBoxContains` understands. X extents are treated as arcs on a circle of
+/// circumference `GLMapPointMax`, so a fleet on both sides of the dateline gets a narrow box instead of a
+/// world-spanning one.
+extension GLMapBBox {
+    static var worldWidth: Double { Double(GLMapPointMax) }
+
+    var isEmpty: Bool { size.x < 0 || size.y < 0 }
+
+    var area: Double { isEmpty ? 0 : size.x * size.y }
+
+    /// Same box with `origin.x` moved into `0..<GLMapPointMax` and width capped at the world width.
+    var wrapNormalized: GLMapBBox {
+        guard !isEmpty else { return self }
+        let w = GLMapBBox.worldWidth
+        var x = origin.x.truncatingRemainder(dividingBy: w)
+        if x < 0 { x += w }
+        return GLMapBBox(origin: GLMapPoint(x: x, y: origin.y), width: min(size.x, w), height: size.y)
+    }
+
+    /// Center with x folded back into the world.
+    var wrappedCenter: GLMapPoint {
+        let c = center
+        let w = GLMapBBox.worldWidth
+        var x = c.x.truncatingRemainder(dividingBy: w)
+        if x < 0 { x += w }
+        return GLMapPoint(x: x, y: c.y)
+    }
+
+    func wrappedContains(_ point: GLMapPoint) -> Bool {
+        guard !isEmpty else { return false }
+        // `contains` tries one world to either side, that is enough once both are in the main world.
+        let p = GLMapBBox(origin: point, width: 0, height: 0).wrapNormalized
+        return wrapNormalized.contains(p.origin)
+    }
+
+    func wrappedIntersects(_ other: GLMapBBox) -> Bool {
+        guard !isEmpty, !other.isEmpty else { return false }
+        let a = wrapNormalized, b = other.wrapNormalized
+        let w = GLMapBBox.worldWidth
+        return a.intersects(bbox: b) || a.intersects(bbox: b.shifted(w)) || a.intersects(bbox: b.shifted(-w))
+    }
+
+    /// Smallest box, going either way around the world, that covers both boxes.
+    func wrappedUnion(_ other: GLMapBBox) -> GLMapBBox {
+        if isEmpty { return other.wrapNormalized }
+        if other.isEmpty { return wrapNormalized }
+        let a = wrapNormalized, b = other.wrapNormalized
+        let w = GLMapBBox.worldWidth
+        let minY = min(a.origin.y, b.origin.y)
+        let maxY = max(a.origin.y + a.size.y, b.origin.y + b.size.y)
+
+        var best = GLMapBBox.empty
+        for shift in [0, w, -w] {
+            let minX = min(a.origin.x, b.origin.x + shift)
+            let maxX = max(a.origin.x + a.size.x, b.origin.x + b.size.x + shift)
+            if best.isEmpty || maxX - minX < best.size.x {
+                best = GLMapBBox(origin: GLMapPoint(x: minX, y: minY), width: maxX - minX, height: maxY - minY)
+            }
+        }
+        return best.wrapNormalized
+    }
+
+    /// Common part of both boxes. When two wrapped boxes overlap on both ends the larger piece is returned.
+    func wrappedIntersection(_ other: GLMapBBox) -> GLMapBBox? {
+        guard !isEmpty, !other.isEmpty else { return nil }
+        let a = wrapNormalized, b = other.wrapNormalized
+        let w = GLMapBBox.worldWidth
+        let minY = max(a.origin.y, b.origin.y)
+        let maxY = min(a.origin.y + a.size.y, b.origin.y + b.size.y)
+        guard minY <= maxY else { return nil }
+
+        var best: GLMapBBox?
+        for shift in [0, w, -w] {
+            let minX = max(a.origin.x, b.origin.x + shift)
+            let maxX = min(a.origin.x + a.size.x, b.origin.x + b.size.x + shift)
+            if minX <= maxX && (best == nil || maxX - minX > best!.size.x) {
+                best = GLMapBBox(origin: GLMapPoint(x: minX, y: minY), width: maxX - minX, height: maxY - minY)
+            }
+        }
+        return best?.wrapNormalized
+    }
+
+    /// Wrap-aware `adding(_:)`: grows towards whichever side, east or west, needs less width.
+    func wrappedAdding(_ point: GLMapPoint) -> GLMapBBox {
+        let p = GLMapBBox(origin: point, width: 0, height: 0)
+        return isEmpty ? p.wrapNormalized : wrappedUnion(p)
+    }
+
+    /// Box with the smallest longitude span containing all points, found from the largest gap between
+    /// neighbouring x coordinates around the circle. O(n log n).
+    init(minimalSpanOf points: [GLMapPoint]) {
+        guard let first = points.first else {
+            self = .empty
+            return
+        }
+        let w = GLMapBBox.worldWidth
+        var minY = first.y, maxY = first.y
+        var xs = [Double]()
+        xs.reserveCapacity(points.count)
+        for p in points {
+            var x = p.x.truncatingRemainder(dividingBy: w)
+            if x < 0 { x += w }
+            xs.append(x)
+            minY = min(minY, p.y)
+            maxY = max(maxY, p.y)
+        }
+        xs.sort()
+
+        // The gap after the last point wraps to the first one.
+        var gap = xs[0] + w - xs[xs.count - 1]
+        var start = xs[0]
+        for i in 1..<xs.count where xs[i] - xs[i - 1] > gap {
+            gap = xs[i] - xs[i - 1]
+            start = xs[i]
+        }
+        self.init(origin: GLMapPoint(x: start, y: minY), width: w - gap, height: maxY - minY)
+    }
+
+    private func shifted(_ dx: Double) -> GLMapBBox {
+        return GLMapBBox(origin: GLMapPoint(x: origin.x + dx, y: origin.y), width: size.x, height: size.y)
+    }
+}
@@ -0,0 +1,220 @@
+//
+//  GeoBatch+Distance.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import Accelerate
+import GLMap
+
+/// Latitudes and longitudes in separate contiguous arrays, the layout batch kernels want.
+struct GeoPointColumns {
+    var lats: [Double]
+    var lons: [Double]
+
+    var count: Int { lats.count }
+
+    init(lats: [Double], lons: [Double]) {
+        precondition(lats.count == lons.count)
+        self.lats = lats
+        self.lons = lons
+    }
+
+    init(_ points: [GLMapGeoPoint]) {
+        let n = points.count
+        var lats = [Double](repeating: 0, count: n)
+        var lons = [Double](repeating: 0, count: n)
+        points.withUnsafeBytes { raw in
+            guard let src = raw.baseAddress?.assumingMemoryBound(to: Double.self) else { return }
+            var one = 1.0
+            vDSP_vsmulD(src, 2, &one, &lats, 1, vDSP_Length(n))
+            vDSP_vsmulD(src + 1, 2, &one, &lons, 1, vDSP_Length(n))
+        }
+        self.lats = lats
+        self.lons = lons
+    }
+
+    init(mapPoints: [GLMapPoint]) {
+        self.init(GeoBatch.geoPoints(from: mapPoints))
+    }
+}
+
+enum GeoDistanceAccuracy {
+    /// Great-circle distance on a sphere, matches `GLMapGeoPoint.distanceTo` closely at any range.
+    case haversine
+    /// Flat-earth approximation scaled by the mean latitude. Error stays under 0.1% below ~50 km.
+    case equirectangular
+}
+
+extension GeoBatch {
+    private static let batchChunk = 1024
+
+    /// Sphere radius used by the framework, taken from its own distance function once.
+    private static let earthRadius: Double = {
+        let d = GLMapGeoPoint(lat: 0, lon: 0).distanceTo(GLMapGeoPoint(lat: 0, lon: 1))
+        return d / (Double.pi / 180)
+    }()
+
+    /// Distances in meters from `origin` to every point of `targets`.
+    static func distances(from origin: GLMapGeoPoint, to targets: GeoPointColumns, accuracy: GeoDistanceAccuracy = .haversine) -> [Double] {
+        return oneToMany(origin, targets) { lat1, lon1, lat2, lon2, out, n in
+            distanceKernel(lat1, lon1, lat2, lon2, out, n, accuracy)
+        }
+    }
+
+    /// Distances in meters between `a[i]` and `b[i]`.
+    static func distances(between a: GeoPointColumns, and b: GeoPointColumns, accuracy: GeoDistanceAccuracy = .haversine) -> [Double] {
+        return pairwise(a, b) { lat1, lon1, lat2, lon2, out, n in
+            distanceKernel(lat1, lon1, lat2, lon2, out, n, accuracy)
+        }
+    }
+
+    /// Initial bearings in degrees, clockwise from north in [0, 360), from `origin` to every point of `targets`.
+    static func bearings(from origin: GLMapGeoPoint, to targets: GeoPointColumns) -> [Double] {
+        return oneToMany(origin, targets, bearingKernel)
+    }
+
+    /// Initial bearings in degrees from `a[i]` to `b[i]`.
+    static func bearings(between a: GeoPointColumns, and b: GeoPointColumns) -> [Double] {
+        return pairwise(a, b, bearingKernel)
+    }
+
+    private typealias Kernel = (UnsafePointer<Double>, UnsafePointer<Double>, UnsafePointer<Double>, UnsafePointer<Double>, UnsafeMutablePointer<Double>, Int) -> Void
+
+    private static func oneToMany(_ origin: GLMapGeoPoint, _ targets: GeoPointColumns, _ kernel: Kernel) -> [Double] {
+        let n = targets.count
+        let chunk = min(n, batchChunk)
+        let originLats = [Double](repeating: origin.lat, count: chunk)
+        let originLons = [Double](repeating: origin.lon, count: chunk)
+        return [Double](unsafeUninitializedCapacity: n) { out, initialized in
+            originLats.withUnsafeBufferPointer { lat1 in
+                originLons.withUnsafeBufferPointer { lon1 in
+                    targets.lats.withUnsafeBufferPointer { lat2 in
+                        targets.lons.withUnsafeBufferPointer { lon2 in
+                            var start = 0
+                            while start < n {
+                                let len = min(chunk, n - start)
+                                kernel(lat1.baseAddress!, lon1.baseAddress!,
+                                       lat2.baseAddress! + start, lon2.baseAddress! + start,
+                                       out.baseAddress! + start, len)
+                                start += len
+                            }
+                        }
+                    }
+                }
+            }
+            initialized = n
+        }
+    }
+
+    private static func pairwise(_ a: GeoPointColumns, _ b: GeoPointColumns, _ kernel: Kernel) -> [Double] {
+        precondition(a.count == b.count)
+        let n = a.count
+        return [Double](unsafeUninitializedCapacity: n) { out, initialized in
+            a.lats.withUnsafeBufferPointer { lat1 in
+                a.lons.withUnsafeBufferPointer { lon1 in
+                    b.lats.withUnsafeBufferPointer { lat2 in
+                        b.lons.withUnsafeBufferPointer { lon2 in
+                            var start = 0
+                            while start < n {
+                                let len = min(batchChunk, n - start)
+                                kernel(lat1.baseAddress! + start, lon1.baseAddress! + start,
+                                       lat2.baseAddress! + start, lon2.baseAddress! + start,
+                                       out.baseAddress! + start, len)
+                                start += len
+                            }
+                        }
+                    }
+                }
+            }
+            initialized = n
+        }
+    }
+
+    // Arithmetic is left to the auto-vectorizer, transcendental functions go through vForce.
+    private static func distanceKernel(_ lat1: UnsafePointer<Double>, _ lon1: UnsafePointer<Double>,
+                                       _ lat2: UnsafePointer<Double>, _ lon2: UnsafePointer<Double>,
+                                       _ out: UnsafeMutablePointer<Double>, _ n: Int, _ accuracy: GeoDistanceAccuracy) {
+        let rad = Double.pi / 180
+        let r = earthRadius
+        var n32 = Int32(n)
+        let s = UnsafeMutablePointer<Double>.allocate(capacity: 3 * n)
+        defer { s.deallocate() }
+        let a = s, b = s + n, c = s + 2 * n
+
+        switch accuracy {
+        case .haversine:
+            for i in 0..<n {
+                a[i] = (lat2[i] - lat1[i]) * (rad / 2)
+                b[i] = (lon2[i] - lon1[i]) * (rad / 2)
+            }
+            vvsin(a, a, &n32)
+            vvsin(b, b, &n32)
+            for i in 0..<n {
+                c[i] = lat1[i] * rad
+                out[i] = lat2[i] * rad
+            }
+            vvcos(c, c, &n32)
+            vvcos(out, out, &n32)
+            for i in 0..<n {
+                let h = a[i] * a[i] + c[i] * out[i] * b[i] * b[i]
+                a[i] = h < 0 ? 0 : (h > 1 ? 1 : h)
+            }
+            vvsqrt(a, a, &n32)
+            vvasin(a, a, &n32)
+            for i in 0..<n {
+                out[i] = a[i] * (2 * r)
+            }
+        case .equirectangular:
+            for i in 0..<n {
+                c[i] = (lat1[i] + lat2[i]) * (rad / 2)
+            }
+            vvcos(c, c, &n32)
+            for i in 0..<n {
+                var dlon = lon2[i] - lon1[i]
+                if dlon > 180 { dlon -= 360 } else if dlon < -180 { dlon += 360 }
+                let x = dlon * c[i]
+                let y = lat2[i] - lat1[i]
+                out[i] = x * x + y * y
+            }
+            vvsqrt(out, out, &n32)
+            for i in 0..<n {
+                out[i] *= r * rad
+            }
+        }
+    }
+
+    private static func bearingKernel(_ lat1: UnsafePointer<Double>, _ lon1: UnsafePointer<Double>,
+                                      _ lat2: UnsafePointer<Double>, _ lon2: UnsafePointer<Double>,
+                                      _ out: UnsafeMutablePointer<Double>, _ n: Int) {
+        let rad = Double.pi / 180
+        var n32 = Int32(n)
+        let s = UnsafeMutablePointer<Double>.allocate(capacity: 7 * n)
+        defer { s.deallocate() }
+        let sin1 = s, cos1 = s + n, sin2 = s + 2 * n, cos2 = s + 3 * n, sinD = s + 4 * n, cosD = s + 5 * n, t = s + 6 * n
+
+        for i in 0..<n {
+            t[i] = lat1[i] * rad
+        }
+        vvsincos(sin1, cos1, t, &n32)
+        for i in 0..<n {
+            t[i] = lat2[i] * rad
+        }
+        vvsincos(sin2, cos2, t, &n32)
+        for i in 0..<n {
+            t[i] = (lon2[i] - lon1[i]) * rad
+        }
+        vvsincos(sinD, cosD, t, &n32)
+        for i in 0..<n {
+            sinD[i] = sinD[i] * cos2[i]
+            cosD[i] = cos1[i] * sin2[i] - sin1[i] * cos2[i] * cosD[i]
+        }
+        vvatan2(out, sinD, cosD, &n32)
+        for i in 0..<n {
+            let deg = out[i] / rad
+            out[i] = deg < 0 ? deg + 360 : deg
+        }
+    }
+}
@@ -0,0 +1,145 @@
+//
+//  GeoBatch.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import Accelerate
+import GLMap
+
+/// Array variants of `GLMapPoint(lat:lon:)` / `GLMapGeoPoint(point:)`.
+///
+/// Mercator math runs through Accelerate (vDSP + vForce), which is NEON-vectorized on device.
+/// The affine part of the projection is calibrated once against the framework's own scalar
+/// conversion, so batch results agree with the per-point functions to within a few ULP of the
+/// `atanh`/`sinh` evaluation (well below 1e-6 map units for |lat| < 85°).
+enum GeoBatch {
+    /// Inputs shorter than this go through the scalar path, vForce setup is not worth it.
+    static let scalarThreshold = 16
+    private static let chunkSize = 4096
+    private static let degToRad = Double.pi / 180
+    private static let radToDeg = 180 / Double.pi
+
+    private struct Mercator {
+        let scaleX: Double
+        let offsetX: Double
+        let scaleY: Double
+        let offsetY: Double
+
+        static let shared: Mercator = {
+            let origin = GLMapPoint(lat: 0, lon: 0)
+            let east = GLMapPoint(lat: 0, lon: 90)
+            let north = GLMapPoint(lat: 45, lon: 0)
+            return Mercator(scaleX: (east.x - origin.x) / 90,
+                            offsetX: origin.x,
+                            scaleY: (north.y - origin.y) / atanh(sin(45 * degToRad)),
+                            offsetY: origin.y)
+        }()
+    }
+
+    static func mapPoint(from geoPoint: GLMapGeoPoint) -> GLMapPoint {
+        let m = Mercator.shared
+        return GLMapPoint(x: geoPoint.lon * m.scaleX + m.offsetX,
+                          y: atanh(sin(geoPoint.lat * degToRad)) * m.scaleY + m.offsetY)
+    }
+
+    static func geoPoint(from point: GLMapPoint) -> GLMapGeoPoint {
+        let m = Mercator.shared
+        return GLMapGeoPoint(lat: atan(sinh((point.y - m.offsetY) / m.scaleY)) * radToDeg,
+                             lon: (point.x - m.offsetX) / m.scaleX)
+    }
+
+    /// Converts `count` geo points into map points. `source` and `destination` may alias.
+    static func mapPoints(from source: UnsafePointer<GLMapGeoPoint>, into destination: UnsafeMutablePointer<GLMapPoint>, count: Int) {
+        if count < scalarThreshold {
+            for i in 0..<count {
+                destination[i] = mapPoint(from: source[i])
+            }
+            return
+        }
+        let m = Mercator.shared
+        let src = UnsafeRawPointer(source).assumingMemoryBound(to: Double.self)
+        let dst = UnsafeMutableRawPointer(destination).assumingMemoryBound(to: Double.self)
+        var scratch = [Double](repeating: 0, count: min(count, chunkSize))
+        scratch.withUnsafeMutableBufferPointer { tmp in
+            let t = tmp.baseAddress!
+            var start = 0
+            while start < count {
+                let n = min(chunkSize, count - start)
+                var n32 = Int32(n)
+                let lat = src + 2 * start
+                let lon = lat + 1
+                let x = dst + 2 * start
+                let y = x + 1
+                var deg = degToRad, sx = m.scaleX, ox = m.offsetX, sy = m.scaleY, oy = m.offsetY
+                // Latitude is read before x is written, so in-place conversion is safe.
+                vDSP_vsmulD(lat, 2, &deg, t, 1, vDSP_Length(n))
+                vDSP_vsmsaD(lon, 2, &sx, &ox, x, 2, vDSP_Length(n))
+                vvsin(t, t, &n32)
+                vvatanh(t, t, &n32)
+                vDSP_vsmsaD(t, 1, &sy, &oy, y, 2, vDSP_Length(n))
+                start += n
+            }
+        }
+    }
+
+    /// Converts `count` map points into geo points. `source` and `destination` may alias.
+    static func geoPoints(from source: UnsafePointer<GLMapPoint>, into destination: UnsafeMutablePointer<GLMapGeoPoint>, count: Int) {
+        if count < scalarThreshold {
+            for i in 0..<count {
+                destination[i] = geoPoint(from: source[i])
+            }
+            return
+        }
+        let m = Mercator.shared
+        let src = UnsafeRawPointer(source).assumingMemoryBound(to: Double.self)
+        let dst = UnsafeMutableRawPointer(destination).assumingMemoryBound(to: Double.self)
+        var scratch = [Double](repeating: 0, count: min(count, chunkSize))
+        scratch.withUnsafeMutableBufferPointer { tmp in
+            let t = tmp.baseAddress!
+            var start = 0
+            while start < count {
+                let n = min(chunkSize, count - start)
+                var n32 = Int32(n)
+                let x = src + 2 * start
+                let y = x + 1
+                let lat = dst + 2 * start
+                let lon = lat + 1
+                var sy = 1 / m.scaleY, oy = -m.offsetY / m.scaleY
+                var sx = 1 / m.scaleX, ox = -m.offsetX / m.scaleX
+                var deg = radToDeg
+                // y goes to scratch and x to lon before lat (aliasing x) is written.
+                vDSP_vsmsaD(y, 2, &sy, &oy, t, 1, vDSP_Length(n))
+                vDSP_vsmsaD(x, 2, &sx, &ox, lon, 2, vDSP_Length(n))
+                vvsinh(t, t, &n32)
+                vvatan(t, t, &n32)
+                vDSP_vsmulD(t, 1, &deg, lat, 2, vDSP_Length(n))
+                start += n
+            }
+        }
+    }
+
+    static func mapPoints(from geoPoints: [GLMapGeoPoint]) -> [GLMapPoint] {
+        return [GLMapPoint](unsafeUninitializedCapacity: geoPoints.count) { buffer, initialized in
+            geoPoints.withUnsafeBufferPointer { src in
+                if let base = src.baseAddress {
+                    mapPoints(from: base, into: buffer.baseAddress!, count: src.count)
+                }
+            }
+            initialized = geoPoints.count
+        }
+    }
+
+    static func geoPoints(from points: [GLMapPoint]) -> [GLMapGeoPoint] {
+        return [GLMapGeoPoint](unsafeUninitializedCapacity: points.count) { buffer, initialized in
+            points.withUnsafeBufferPointer { src in
+                if let base = src.baseAddress {
+                    geoPoints(from: base, into: buffer.baseAddress!, count: src.count)
+                }
+            }
+            initialized = points.count
+        }
+    }
+}
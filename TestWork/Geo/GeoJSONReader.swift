@@ -0,0 +1,488 @@
+//
+//  GeoJSONReader.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// GeoJSON loader for large zone and geofence layers, the two-stage counterpart of
+/// `GLMapVectorObject createVectorObjectsFromGeoJSONData:`.
+///
+/// The first stage indexes the positions of every structural character outside strings, 64 bytes at a
+/// time with SIMD compares; string state is carried between blocks with a prefix xor of the quote mask.
+/// The second stage walks that index instead of the bytes, parses coordinates with `NumberParser` and
+/// adds objects to the result as soon as each feature is complete.
+enum GeoJSONReader {
+    /// Vector objects with their properties, `nil` if the data is not valid GeoJSON.
+    static func objects(from data: Data) -> GLMapVectorObjectArray? {
+        return data.withUnsafeBytes { bytes -> GLMapVectorObjectArray? in
+            guard let index = StructuralIndex.build(bytes), !index.isEmpty else { return nil }
+            let result = GLMapVectorObjectArray()
+            var walker = Walker(bytes: bytes, index: index)
+            guard let root = walker.object(result), walker.atEnd else { return nil }
+            emit(root, properties: [], to: result)
+            return result
+        }
+    }
+
+    static func objects(contentsOf url: URL) -> GLMapVectorObjectArray? {
+        guard let data = try? Data(contentsOf: url, options: .alwaysMapped) else { return nil }
+        return objects(from: data)
+    }
+
+    // MARK: Objects
+
+    fileprivate static func emit(_ node: Node, properties: [(String, String)], to out: GLMapVectorObjectArray) {
+        let properties = node.properties.isEmpty ? properties : node.properties
+        switch node.type {
+        case "FeatureCollection":
+            // Features were added while walking.
+            break
+        case "Feature", "GeometryCollection":
+            for child in node.children {
+                emit(child, properties: properties, to: out)
+            }
+        default:
+            for object in makeObjects(node.type, node.coordinates) {
+                for (key, value) in properties {
+                    object.setValue(value, forKey: key)
+                }
+                out.add(object)
+            }
+        }
+    }
+
+    private static func makeObjects(_ type: String, _ c: Coordinates) -> [GLMapVectorObject] {
+        func ring(_ run: Int) -> GLMapPointArray {
+            let lo = run > 0 ? c.runs[run - 1] : 0
+            return c.points.withUnsafeBufferPointer { buffer in
+                GLMapPointArray(points: UnsafeMutablePointer(mutating: buffer.baseAddress! + lo), count: UInt(c.runs[run] - lo))
+            }
+        }
+
+        switch type {
+        case "Point":
+            guard c.height == 1, let p = c.points.first else { return [] }
+            return [GLMapVectorPoint(p)]
+        case "MultiPoint":
+            return c.points.map { GLMapVectorPoint($0) }
+        case "LineString", "MultiLineString":
+            guard !c.runs.isEmpty else { return [] }
+            return [GLMapVectorLine(lines: c.runs.indices.map(ring))]
+        case "Polygon", "MultiPolygon":
+            var outer: [GLMapPointArray] = []
+            var inner: [GLMapPointArray] = []
+            var run = 0
+            for end in c.polygons where run < end {
+                outer.append(ring(run))
+                inner += (run + 1..<end).map(ring)
+                run = end
+            }
+            guard !outer.isEmpty else { return [] }
+            return [GLMapVectorPolygon(outer, innerRings: inner)]
+        default:
+            return []
+        }
+    }
+}
+
+// MARK: - Parsed tree
+
+/// GeoJSON object: a feature collection, feature or geometry. Features inside a collection are emitted
+/// as they are parsed and never stored here.
+private struct Node {
+    var type = ""
+    var coordinates = Coordinates()
+    /// Geometry of a feature or members of a geometry collection.
+    var children: [Node] = []
+    var properties: [(String, String)] = []
+}
+
+/// Positions of any nesting depth, flattened.
+private struct Coordinates {
+    var points: [GLMapPoint] = []
+    /// End of each line or ring in `points`.
+    var runs: [Int] = []
+    /// End of each polygon in `runs`.
+    var polygons: [Int] = []
+    /// 1 for a single position, 2 for a list of positions and so on.
+    var height = 0
+}
+
+private let quote = UInt8(ascii: "\"")
+private let backslash = UInt8(ascii: "\\")
+private let openBrace = UInt8(ascii: "{")
+private let closeBrace = UInt8(ascii: "}")
+private let openBracket = UInt8(ascii: "[")
+private let closeBracket = UInt8(ascii: "]")
+private let colon = UInt8(ascii: ":")
+private let comma = UInt8(ascii: ",")
+
+// MARK: - Stage 1
+
+private enum StructuralIndex {
+    /// Offsets of `{ } [ ] : ,` outside strings and of every unescaped quote, `nil` on an unterminated string.
+    static func build(_ bytes: UnsafeRawBufferPointer) -> [UInt32]? {
+        guard let base = bytes.baseAddress, bytes.count < Int(UInt32.max) else { return nil }
+        var index: [UInt32] = []
+        index.reserveCapacity(bytes.count / 8)
+        var inString: UInt64 = 0
+        var escapeCarry = false
+        var tail = [UInt8](repeating: 0x20, count: 64)
+
+        var block = 0
+        while block < bytes.count {
+            let masks: (quotes: UInt64, backslashes: UInt64, structural: UInt64)
+            if block + 64 <= bytes.count {
+                masks = classify(base + block)
+            } else {
+                for k in 0..<64 {
+                    tail[k] = block + k < bytes.count ? bytes[block + k] : 0x20
+                }
+                masks = tail.withUnsafeBytes { classify($0.baseAddress!) }
+            }
+
+            // A byte is escaped when an odd run of backslashes precedes it. Backslashes are rare outside
+            // of text properties, so they are resolved one at a time.
+            var escaped: UInt64 = escapeCarry ? 1 : 0
+            escapeCarry = false
+            var slashes = masks.backslashes
+            while slashes != 0 {
+                let i = slashes.trailingZeroBitCount
+                slashes &= slashes - 1
+                guard escaped & (1 << UInt64(i)) == 0 else { continue }
+                if i == 63 {
+                    escapeCarry = true
+                } else {
+                    escaped |= 1 << UInt64(i + 1)
+                }
+            }
+
+            let quotes = masks.quotes & ~escaped
+            let inside = prefixXor(quotes) ^ inString
+            inString = UInt64(bitPattern: Int64(bitPattern: inside) >> 63)
+            var bits = (masks.structural & ~inside) | quotes
+            while bits != 0 {
+                index.append(UInt32(block + bits.trailingZeroBitCount))
+                bits &= bits - 1
+            }
+            block += 64
+        }
+        return inString == 0 ? index : nil
+    }
+
+    private static func classify(_ p: UnsafeRawPointer) -> (quotes: UInt64, backslashes: UInt64, structural: UInt64) {
+        var quotes: UInt64 = 0, backslashes: UInt64 = 0, structural: UInt64 = 0
+        for lane in 0..<4 {
+            let v = p.loadUnaligned(fromByteOffset: 16 * lane, as: SIMD16<UInt8>.self)
+            let shift = UInt64(16 * lane)
+            quotes |= UInt64((v .== quote).bits) << shift
+            backslashes |= UInt64((v .== backslash).bits) << shift
+            let braces = (v .== openBrace) .| (v .== closeBrace)
+            let brackets = (v .== openBracket) .| (v .== closeBracket)
+            let separators = (v .== colon) .| (v .== comma)
+            structural |= UInt64((braces .| brackets .| separators).bits) << shift
+        }
+        return (quotes, backslashes, structural)
+    }
+
+    /// Bit i of the result is the xor of bits 0...i: set from an opening quote up to its closing quote.
+    private static func prefixXor(_ x: UInt64) -> UInt64 {
+        var x = x
+        x ^= x << 1
+        x ^= x << 2
+        x ^= x << 4
+        x ^= x << 8
+        x ^= x << 16
+        x ^= x << 32
+        return x
+    }
+}
+
+// MARK: - Stage 2
+
+private struct Walker {
+    let bytes: UnsafeRawBufferPointer
+    let index: [UInt32]
+    var cursor = 0
+
+    /// Structural character at the cursor, 0 past the end.
+    var peek: UInt8 { cursor < index.count ? bytes[Int(index[cursor])] : 0 }
+    var position: Int { cursor < index.count ? Int(index[cursor]) : bytes.count }
+
+    /// Whether everything after the root value is whitespace.
+    var atEnd: Bool {
+        guard cursor == index.count else { return false }
+        return UnsafeRawBufferPointer(rebasing: bytes[valueStart()...]).isEmpty
+    }
+
+    init(bytes: UnsafeRawBufferPointer, index: [UInt32]) {
+        self.bytes = bytes
+        self.index = index
+    }
+
+    mutating func expect(_ c: UInt8) -> Bool {
+        guard peek == c else { return false }
+        cursor += 1
+        return true
+    }
+
+    /// First non-space byte after the previous structural character, where the next value starts.
+    func valueStart() -> Int {
+        var p = cursor > 0 ? Int(index[cursor - 1]) + 1 : 0
+        while p < bytes.count && NumberParser.isSpace(bytes[p]) {
+            p += 1
+        }
+        return p
+    }
+
+    /// Whether the next value starts with `c`. Numbers, literals and null are not indexed, so they never match.
+    func next(is c: UInt8) -> Bool {
+        return peek == c && valueStart() == position
+    }
+
+    func key(_ range: Range<Int>, is name: StaticString) -> Bool {
+        let expected = UnsafeRawBufferPointer(start: name.utf8Start, count: name.utf8CodeUnitCount)
+        return UnsafeRawBufferPointer(rebasing: bytes[range]).elementsEqual(expected)
+    }
+
+    // MARK: Values
+
+    /// Contents of the string at the cursor, without quotes.
+    mutating func stringRange() -> Range<Int>? {
+        guard next(is: quote), cursor + 1 < index.count else { return nil }
+        let range = Int(index[cursor]) + 1..<Int(index[cursor + 1])
+        cursor += 2
+        return range
+    }
+
+    mutating func string() -> String? {
+        return stringRange().map(decode)
+    }
+
+    /// Skips any value and returns its source text range.
+    mutating func skipValue() -> Range<Int>? {
+        let start = valueStart()
+        guard start == position else {
+            // A bare number, literal or null runs up to the next structural character.
+            var end = position
+            while end > start && NumberParser.isSpace(bytes[end - 1]) {
+                end -= 1
+            }
+            return end > start ? start..<end : nil
+        }
+        if peek == quote {
+            guard cursor + 1 < index.count else { return nil }
+            cursor += 2
+            return start..<Int(index[cursor - 1]) + 1
+        }
+        guard peek == openBrace || peek == openBracket else { return nil }
+        var depth = 0
+        repeat {
+            switch peek {
+            case openBrace, openBracket:
+                depth += 1
+            case closeBrace, closeBracket:
+                depth -= 1
+            case 0:
+                return nil
+            default:
+                break
+            }
+            cursor += 1
+        } while depth > 0
+        return start..<Int(index[cursor - 1]) + 1
+    }
+
+    /// Calls `member` for each key of the object at the cursor, with the cursor on the value; `member`
+    /// consumes the value.
+    mutating func members(_ member: (inout Walker, Range<Int>) -> Bool) -> Bool {
+        guard next(is: openBrace), expect(openBrace) else { return false }
+        if expect(closeBrace) { return true }
+        repeat {
+            guard let key = stringRange(), expect(colon), member(&self, key) else { return false }
+        } while expect(comma)
+        return expect(closeBrace)
+    }
+
+    mutating func elements(_ element: (inout Walker) -> Bool) -> Bool {
+        guard next(is: openBracket), expect(openBracket) else { return false }
+        if expect(closeBracket) { return true }
+        repeat {
+            guard element(&self) else { return false }
+        } while expect(comma)
+        return expect(closeBracket)
+    }
+
+    // MARK: GeoJSON
+
+    /// Any GeoJSON object. Members of "features" are emitted to `out` one by one.
+    mutating func object(_ out: GLMapVectorObjectArray) -> Node? {
+        var node = Node()
+        let ok = members { w, key in
+            if w.key(key, is: "type") {
+                guard let type = w.string() else { return false }
+                node.type = type
+                return true
+            }
+            if w.key(key, is: "coordinates") {
+                return w.coordinates(&node.coordinates) != nil
+            }
+            if w.key(key, is: "geometry") && w.next(is: openBrace) {
+                guard let child = w.object(out) else { return false }
+                node.children.append(child)
+                return true
+            }
+            if w.key(key, is: "geometries") {
+                return w.elements { w in
+                    guard let child = w.object(out) else { return false }
+                    node.children.append(child)
+                    return true
+                }
+            }
+            if w.key(key, is: "features") {
+                return w.elements { w in
+                    guard let feature = w.object(out) else { return false }
+                    GeoJSONReader.emit(feature, properties: [], to: out)
+                    return true
+                }
+            }
+            if w.key(key, is: "properties") && w.next(is: openBrace) {
+                return w.properties(&node.properties)
+            }
+            return w.skipValue() != nil
+        }
+        return ok ? node : nil
+    }
+
+    /// Flat properties: strings as they are, numbers and literals as written, nested values as JSON text.
+    mutating func properties(_ result: inout [(String, String)]) -> Bool {
+        return members { w, key in
+            let name = w.decode(key)
+            if w.next(is: quote) {
+                guard let value = w.string() else { return false }
+                result.append((name, value))
+                return true
+            }
+            guard let range = w.skipValue() else { return false }
+            let raw = UnsafeRawBufferPointer(rebasing: w.bytes[range])
+            if !raw.elementsEqual("null".utf8) {
+                result.append((name, String(decoding: raw, as: UTF8.self)))
+            }
+            return true
+        }
+    }
+
+    /// Parses a coordinates array of any depth into `c` and returns its height.
+    mutating func coordinates(_ c: inout Coordinates) -> Int? {
+        guard next(is: openBracket), expect(openBracket) else { return nil }
+        let start = valueStart()
+        guard start < bytes.count else { return nil }
+
+        if bytes[start] != openBracket && bytes[start] != closeBracket {
+            // A position: parse the whole run of numbers at once and skip the commas inside it. Only
+            // longitude and latitude are kept; altitude and any further values are read past.
+            let (count, end) = withUnsafeTemporaryAllocation(of: Double.self, capacity: 4) { values -> (Int, Int) in
+                var parsed = NumberParser.parseDoubles(UnsafeRawBufferPointer(rebasing: bytes[start...]), into: values)
+                guard parsed.count >= 2 else { return (0, start) }
+                c.points.append(GLMapPoint(lat: values[1], lon: values[0]))
+                var count = parsed.count
+                var end = start + parsed.consumed
+                while parsed.count == values.count {
+                    parsed = NumberParser.parseDoubles(UnsafeRawBufferPointer(rebasing: bytes[end...]), into: values)
+                    count += parsed.count
+                    end += parsed.consumed
+                }
+                return (count, end)
+            }
+            guard count >= 2 else { return nil }
+            // The run must stop right at the closing bracket, with one comma between each two numbers: this
+            // rejects "[1,2 3]", "[1,2,]" and "[1,2,abc]".
+            var commas = 0
+            while cursor < index.count && Int(index[cursor]) < end {
+                guard peek == comma else { return nil }
+                commas += 1
+                cursor += 1
+            }
+            guard commas == count - 1, position == end, expect(closeBracket) else { return nil }
+            c.height = max(c.height, 1)
+            return 1
+        }
+
+        if expect(closeBracket) { return 0 }
+        var height = 0
+        repeat {
+            guard let h = coordinates(&c), h == 0 || height == 0 || h == height else { return nil }
+            height = max(height, h)
+        } while expect(comma)
+        guard expect(closeBracket) else { return nil }
+        if height == 1 {
+            c.runs.append(c.points.count)
+        } else if height == 2 {
+            c.polygons.append(c.runs.count)
+        }
+        c.height = max(c.height, height + 1)
+        return height + 1
+    }
+
+    // MARK: Strings
+
+    func decode(_ range: Range<Int>) -> String {
+        let raw = UnsafeRawBufferPointer(rebasing: bytes[range])
+        guard raw.contains(backslash) else { return String(decoding: raw, as: UTF8.self) }
+
+        var out: [UInt8] = []
+        out.reserveCapacity(raw.count)
+        var i = 0
+        func hex() -> UInt32? {
+            guard i + 4 <= raw.count, let v = UInt32(String(decoding: raw[i..<i + 4], as: UTF8.self), radix: 16) else { return nil }
+            i += 4
+            return v
+        }
+        while i < raw.count {
+            let b = raw[i]
+            i += 1
+            guard b == backslash, i < raw.count else {
+                out.append(b)
+                continue
+            }
+            let e = raw[i]
+            i += 1
+            switch e {
+            case UInt8(ascii: "n"): out.append(0x0A)
+            case UInt8(ascii: "t"): out.append(0x09)
+            case UInt8(ascii: "r"): out.append(0x0D)
+            case UInt8(ascii: "b"): out.append(0x08)
+            case UInt8(ascii: "f"): out.append(0x0C)
+            case UInt8(ascii: "u"):
+                guard var v = hex() else { continue }
+                if (0xD800..<0xDC00).contains(v) {
+                    // Combine with a following low surrogate; a lone high surrogate becomes U+FFFD and the
+                    // escape after it, if any, is decoded on its own.
+                    let mark = i
+                    if i + 6 <= raw.count, raw[i] == backslash, raw[i + 1] == UInt8(ascii: "u") {
+                        i += 2
+                        if let low = hex(), (0xDC00..<0xE000).contains(low) {
+                            v = 0x10000 + ((v - 0xD800) << 10) + (low - 0xDC00)
+                        }
+                    }
+                    if v < 0x10000 {
+                        v = 0xFFFD
+                        i = mark
+                    }
+                } else if (0xDC00..<0xE000).contains(v) {
+                    v = 0xFFFD
+                }
+                if let scalar = Unicode.Scalar(v) {
+                    UTF8.encode(scalar) { out.append($0) }
+                }
+            default:
+                out.append(e)
+            }
+        }
+        return String(decoding: out, as: UTF8.self)
+    }
+}
@@ -0,0 +1,201 @@
+//
+//  MapBBoxIndex.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Bounding box set with id queries, removal and moving boxes. Complements `GLMapBBoxSet`, which can only
+/// grow and only answers whether anything intersects.
+///
+/// Backed by a loose quadtree: a box is stored once, in the cell of its center at the deepest level whose
+/// cell size is not smaller than the box. Cells are looked up in per-level hash maps, so updates are O(1)
+/// and a query visits only levels that hold boxes and, on each, only cells whose loose bounds overlap.
+final class MapBBoxIndex {
+    typealias ID = Int
+
+    private struct Slot {
+        var bbox: GLMapBBox
+        var level: Int
+        var key: UInt64
+        var alive: Bool
+    }
+
+    private static let maxLevel = 24
+
+    private let origin: GLMapPoint
+    private let extent: Double
+    private var cellSizes: [Double] = []
+    private var levels: [[UInt64: [ID]]]
+    private var levelCounts: [Int]
+    private var slots: [Slot] = []
+    private var freeIDs: [ID] = []
+
+    private(set) var count = 0
+
+    init(bounds: GLMapBBox = .world) {
+        origin = bounds.origin
+        extent = max(bounds.size.x, bounds.size.y)
+        levels = Array(repeating: [:], count: MapBBoxIndex.maxLevel + 1)
+        levelCounts = Array(repeating: 0, count: MapBBoxIndex.maxLevel + 1)
+        var size = extent
+        for _ in 0...MapBBoxIndex.maxLevel {
+            cellSizes.append(size)
+            size /= 2
+        }
+    }
+
+    // MARK: Updates
+
+    /// Stores a box and returns its id. Ids of removed boxes are handed out again, so an id must not be
+    /// used after `remove` or `removeAll`: it may already name another box.
+    @discardableResult
+    func insert(_ bbox: GLMapBBox) -> ID {
+        let (level, key) = place(bbox)
+        let slot = Slot(bbox: bbox, level: level, key: key, alive: true)
+        let id: ID
+        if let reused = freeIDs.popLast() {
+            id = reused
+            slots[id] = slot
+        } else {
+            id = slots.count
+            slots.append(slot)
+        }
+        link(id, level, key)
+        count += 1
+        return id
+    }
+
+    @discardableResult
+    func remove(_ id: ID) -> Bool {
+        guard id >= 0, id < slots.count, slots[id].alive else { return false }
+        unlink(id, slots[id].level, slots[id].key)
+        slots[id].alive = false
+        freeIDs.append(id)
+        count -= 1
+        return true
+    }
+
+    /// Moves a box. When it stays in the same cell only the stored bbox changes.
+    func update(_ id: ID, to bbox: GLMapBBox) {
+        guard id >= 0, id < slots.count, slots[id].alive else { return }
+        let (level, key) = place(bbox)
+        if level != slots[id].level || key != slots[id].key {
+            unlink(id, slots[id].level, slots[id].key)
+            link(id, level, key)
+            slots[id].level = level
+            slots[id].key = key
+        }
+        slots[id].bbox = bbox
+    }
+
+    func bbox(for id: ID) -> GLMapBBox? {
+        guard id >= 0, id < slots.count, slots[id].alive else { return nil }
+        return slots[id].bbox
+    }
+
+    func removeAll() {
+        for level in 0..<levels.count where levelCounts[level] > 0 {
+            levels[level].removeAll(keepingCapacity: true)
+            levelCounts[level] = 0
+        }
+        slots.removeAll(keepingCapacity: true)
+        freeIDs.removeAll(keepingCapacity: true)
+        count = 0
+    }
+
+    // MARK: Queries
+
+    /// Same as `GLMapBBoxSetTest`: true if any stored box intersects `bbox`.
+    func test(_ bbox: GLMapBBox) -> Bool {
+        var found = false
+        visit(bbox) { _ in
+            found = true
+            return false
+        }
+        return found
+    }
+
+    /// Calls `body` with the id of every stored box intersecting `bbox`.
+    func query(_ bbox: GLMapBBox, _ body: (ID) -> Void) {
+        visit(bbox) { id in
+            body(id)
+            return true
+        }
+    }
+
+    func query(_ bbox: GLMapBBox) -> [ID] {
+        var result: [ID] = []
+        query(bbox) { result.append($0) }
+        return result
+    }
+
+    // MARK: Cells
+
+    private func place(_ bbox: GLMapBBox) -> (Int, UInt64) {
+        let size = max(bbox.size.x, bbox.size.y)
+        var level = MapBBoxIndex.maxLevel
+        while level > 0 && cellSizes[level] < size {
+            level -= 1
+        }
+        let center = bbox.center
+        return (level, cellKey(cell(center.x - origin.x, level), cell(center.y - origin.y, level)))
+    }
+
+    private func cell(_ offset: Double, _ level: Int) -> Int {
+        let c = Int((offset / cellSizes[level]).rounded(.down))
+        return min(max(c, 0), (1 << level) - 1)
+    }
+
+    private func cellKey(_ x: Int, _ y: Int) -> UInt64 {
+        return UInt64(x) << 32 | UInt64(y)
+    }
+
+    private func link(_ id: ID, _ level: Int, _ key: UInt64) {
+        levels[level][key, default: []].append(id)
+        levelCounts[level] += 1
+    }
+
+    private func unlink(_ id: ID, _ level: Int, _ key: UInt64) {
+        guard var ids = levels[level][key], let i = ids.firstIndex(of: id) else { return }
+        ids.swapAt(i, ids.count - 1)
+        ids.removeLast()
+        levels[level][key] = ids.isEmpty ? nil : ids
+        levelCounts[level] -= 1
+    }
+
+    /// Visits intersecting boxes until `body` returns false.
+    private func visit(_ bbox: GLMapBBox, _ body: (ID) -> Bool) {
+        // A negative-size box intersects nothing.
+        guard bbox.size.x >= 0 && bbox.size.y >= 0 else { return }
+        for level in 0..<levels.count where levelCounts[level] > 0 {
+            let s = cellSizes[level]
+            let x0 = cell(bbox.origin.x - origin.x - s / 2, level)
+            let x1 = cell(bbox.origin.x + bbox.size.x - origin.x + s / 2, level)
+            let y0 = cell(bbox.origin.y - origin.y - s / 2, level)
+            let y1 = cell(bbox.origin.y + bbox.size.y - origin.y + s / 2, level)
+            let cells = levels[level]
+            guard x0 <= x1 && y0 <= y1 else { continue }
+
+            if (x1 - x0 + 1) * (y1 - y0 + 1) > cells.count {
+                for ids in cells.values {
+                    for id in ids where slots[id].bbox.intersects(bbox: bbox) {
+                        if !body(id) { return }
+                    }
+                }
+                continue
+            }
+            for x in x0...x1 {
+                for y in y0...y1 {
+                    guard let ids = cells[cellKey(x, y)] else { continue }
+                    for id in ids where slots[id].bbox.intersects(bbox: bbox) {
+                        if !body(id) { return }
+                    }
+                }
+            }
+        }
+    }
+}
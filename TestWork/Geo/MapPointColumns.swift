@@ -0,0 +1,185 @@
+//
+//  MapPointColumns.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import Accelerate
+import GLMap
+
+/// Map points as two contiguous columns of x and y, for vector kernels that `GLMapPointArray`'s interleaved
+/// storage and per-point access get in the way of.
+///
+/// The columns are read-only spans. They are either owned or adopted from the caller without a copy, in
+/// which case `deallocator` runs when the columns are released.
+final class MapPointColumns {
+    typealias Deallocator = (UnsafeMutablePointer<Double>, UnsafeMutablePointer<Double>) -> Void
+
+    private static let chunk = 1024
+
+    private let xBase: UnsafeMutablePointer<Double>
+    private let yBase: UnsafeMutablePointer<Double>
+    private let deallocator: Deallocator?
+
+    let count: Int
+
+    var xs: UnsafeBufferPointer<Double> { UnsafeBufferPointer(start: xBase, count: count) }
+    var ys: UnsafeBufferPointer<Double> { UnsafeBufferPointer(start: yBase, count: count) }
+
+    /// Adopts caller-owned columns of `count` values each. Nothing is copied; the memory must stay valid
+    /// and unchanged until `deallocator` is called.
+    init(adoptingXs xs: UnsafeMutablePointer<Double>, ys: UnsafeMutablePointer<Double>, count: Int, deallocator: Deallocator?) {
+        xBase = xs
+        yBase = ys
+        self.count = count
+        self.deallocator = deallocator
+    }
+
+    convenience init(xs: [Double], ys: [Double]) {
+        precondition(xs.count == ys.count)
+        let (x, y) = MapPointColumns.allocate(xs.count)
+        x.initialize(from: xs, count: xs.count)
+        y.initialize(from: ys, count: ys.count)
+        self.init(adoptingXs: x, ys: y, count: xs.count, deallocator: MapPointColumns.free)
+    }
+
+    convenience init(_ points: UnsafeBufferPointer<GLMapPoint>) {
+        let (x, y) = MapPointColumns.split(points)
+        self.init(adoptingXs: x, ys: y, count: points.count, deallocator: MapPointColumns.free)
+    }
+
+    convenience init(_ points: [GLMapPoint]) {
+        let (x, y) = points.withUnsafeBufferPointer { MapPointColumns.split($0) }
+        self.init(adoptingXs: x, ys: y, count: points.count, deallocator: MapPointColumns.free)
+    }
+
+    convenience init(_ array: GLMapPointArray) {
+        let n = Int(array.count)
+        let (x, y) = MapPointColumns.allocate(n)
+        array.enumeratePoints { i, p in
+            x[Int(i)] = p.x
+            y[Int(i)] = p.y
+        }
+        self.init(adoptingXs: x, ys: y, count: n, deallocator: MapPointColumns.free)
+    }
+
+    deinit {
+        deallocator?(xBase, yBase)
+    }
+
+    subscript(index: Int) -> GLMapPoint {
+        precondition(index >= 0 && index < count)
+        return GLMapPoint(x: xBase[index], y: yBase[index])
+    }
+
+    // MARK: Conversion
+
+    func makePointArray() -> GLMapPointArray {
+        return GLMapPointArray(count: UInt(count)) { [xBase, yBase] i in
+            GLMapPoint(x: xBase[Int(i)], y: yBase[Int(i)])
+        }
+    }
+
+    func interleaved() -> [GLMapPoint] {
+        let n = count
+        return [GLMapPoint](unsafeUninitializedCapacity: n) { buffer, initialized in
+            if let base = buffer.baseAddress {
+                base.withMemoryRebound(to: Double.self, capacity: 2 * n) { dst in
+                    var one = 1.0
+                    vDSP_vsmulD(xBase, 1, &one, dst, 2, vDSP_Length(n))
+                    vDSP_vsmulD(yBase, 1, &one, dst + 1, 2, vDSP_Length(n))
+                }
+            }
+            initialized = n
+        }
+    }
+
+    // MARK: Kernels
+
+    var bbox: GLMapBBox {
+        return MapPointColumns.bbox(xBase, yBase, 1, count)
+    }
+
+    /// Polyline length in map units.
+    var length: Double {
+        return MapPointColumns.length(xBase, yBase, 1, count)
+    }
+
+    /// Same kernels over interleaved points, reading x and y with stride 2.
+    static func bbox(of points: UnsafeBufferPointer<GLMapPoint>) -> GLMapBBox {
+        guard let base = points.baseAddress else { return .empty }
+        return base.withMemoryRebound(to: Double.self, capacity: 2 * points.count) { p in
+            bbox(p, p + 1, 2, points.count)
+        }
+    }
+
+    static func length(of points: UnsafeBufferPointer<GLMapPoint>) -> Double {
+        guard let base = points.baseAddress else { return 0 }
+        return base.withMemoryRebound(to: Double.self, capacity: 2 * points.count) { p in
+            length(p, p + 1, 2, points.count)
+        }
+    }
+
+    private static func bbox(_ x: UnsafePointer<Double>, _ y: UnsafePointer<Double>, _ stride: Int, _ n: Int) -> GLMapBBox {
+        guard n > 0 else { return .empty }
+        var minX = 0.0, maxX = 0.0, minY = 0.0, maxY = 0.0
+        let s = vDSP_Stride(stride), len = vDSP_Length(n)
+        vDSP_minvD(x, s, &minX, len)
+        vDSP_maxvD(x, s, &maxX, len)
+        vDSP_minvD(y, s, &minY, len)
+        vDSP_maxvD(y, s, &maxY, len)
+        return GLMapBBox(origin: GLMapPoint(x: minX, y: minY), width: maxX - minX, height: maxY - minY)
+    }
+
+    private static func length(_ x: UnsafePointer<Double>, _ y: UnsafePointer<Double>, _ stride: Int, _ n: Int) -> Double {
+        guard n > 1 else { return 0 }
+        var dx = [Double](repeating: 0, count: chunk)
+        var dy = [Double](repeating: 0, count: chunk)
+        let s = vDSP_Stride(stride)
+        var total = 0.0
+        var start = 0
+        while start < n - 1 {
+            let m = min(chunk, n - 1 - start)
+            let len = vDSP_Length(m)
+            let off = start * stride
+            var sum = 0.0
+            dx.withUnsafeMutableBufferPointer { dx in
+                dy.withUnsafeMutableBufferPointer { dy in
+                    vDSP_vsubD(x + off, s, x + off + stride, s, dx.baseAddress!, 1, len)
+                    vDSP_vsubD(y + off, s, y + off + stride, s, dy.baseAddress!, 1, len)
+                    vDSP_vdistD(dx.baseAddress!, 1, dy.baseAddress!, 1, dx.baseAddress!, 1, len)
+                    vDSP_sveD(dx.baseAddress!, 1, &sum, len)
+                }
+            }
+            total += sum
+            start += m
+        }
+        return total
+    }
+
+    // MARK: Storage
+
+    private static func split(_ points: UnsafeBufferPointer<GLMapPoint>) -> (UnsafeMutablePointer<Double>, UnsafeMutablePointer<Double>) {
+        let n = points.count
+        let (x, y) = allocate(n)
+        if let base = points.baseAddress {
+            base.withMemoryRebound(to: Double.self, capacity: 2 * n) { src in
+                var one = 1.0
+                vDSP_vsmulD(src, 2, &one, x, 1, vDSP_Length(n))
+                vDSP_vsmulD(src + 1, 2, &one, y, 1, vDSP_Length(n))
+            }
+        }
+        return (x, y)
+    }
+
+    private static func allocate(_ n: Int) -> (UnsafeMutablePointer<Double>, UnsafeMutablePointer<Double>) {
+        return (UnsafeMutablePointer<Double>.allocate(capacity: max(n, 1)), UnsafeMutablePointer<Double>.allocate(capacity: max(n, 1)))
+    }
+
+    private static func free(_ x: UnsafeMutablePointer<Double>, _ y: UnsafeMutablePointer<Double>) {
+        x.deallocate()
+        y.deallocate()
+    }
+}
@@ -0,0 +1,453 @@
+//
+//  MapPointIndex.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Point set with k-nearest and radius queries, an app-side counterpart of `GLMapPointSet`.
+/// Every point can carry a 64-bit payload (an id, an index) returned by the `Item` queries.
+///
+/// Points live in an implicit KD-tree (median-split ranges of one contiguous array). Inserts go to
+/// pending trees of power-of-two sizes that merge like a binary counter, so a query visits at most
+/// log n small trees besides the main one. Removals set bits in per-tree tombstone sets and never touch
+/// the trees themselves. Pending points and tombstones are folded back by a rebuild once they exceed a
+/// fraction of the tree, which keeps updates amortized O(log² n) and queries sub-linear.
+///
+/// Trees are immutable between rebuilds, so `copy()` shares them and an update of the copy only
+/// duplicates the small structures it changes: the pending list and one tombstone chunk.
+final class MapPointIndex {
+    struct Item {
+        let point: GLMapPoint
+        let payload: UInt64
+    }
+
+    private struct Entry {
+        var point: GLMapPoint
+        var payload: UInt64 = 0
+    }
+
+    private struct Tree {
+        var entries: [Entry] = []
+        var dead = Tombstones()
+    }
+
+    private var tree = Tree()
+    /// `pending[i]` is empty or a built tree of at most 2^i inserted entries.
+    private var pending: [Tree] = []
+    /// Entries stored in pending trees, tombstoned ones included.
+    private var pendingCount = 0
+    private var deadCount = 0
+
+    private(set) var count = 0
+
+    var isEmpty: Bool { count == 0 }
+
+    init() { }
+
+    /// Bulk-loads the index in O(n log n) into a single allocation, much cheaper than n inserts.
+    init(points: [GLMapPoint]) {
+        reset(points: points)
+    }
+
+    init(items: [Item]) {
+        reset(items: items)
+    }
+
+    /// Replaces the whole content, reusing the existing storage when it is large enough.
+    func reset(points: [GLMapPoint]) {
+        load(points.count) { Entry(point: points[$0]) }
+    }
+
+    func reset(items: [Item]) {
+        load(items.count) { Entry(point: items[$0].point, payload: items[$0].payload) }
+    }
+
+    private func load(_ n: Int, _ entry: (Int) -> Entry) {
+        tree.entries.removeAll(keepingCapacity: true)
+        tree.entries.reserveCapacity(n)
+        for i in 0..<n {
+            tree.entries.append(entry(i))
+        }
+        tree.dead = Tombstones()
+        pending.removeAll()
+        pendingCount = 0
+        deadCount = 0
+        count = n
+        build(&tree.entries, 0, n, 0)
+    }
+
+    /// Independent copy in O(log n + n / 4096). Storage is shared copy-on-write until either side is modified.
+    func copy() -> MapPointIndex {
+        let index = MapPointIndex()
+        index.tree = tree
+        index.pending = pending
+        index.pendingCount = pendingCount
+        index.deadCount = deadCount
+        index.count = count
+        return index
+    }
+
+    // MARK: Updates
+
+    /// Adds a point, duplicates are allowed like in `GLMapPointSetInsert`.
+    func insert(_ point: GLMapPoint, payload: UInt64 = 0) {
+        var carry = [Entry(point: point, payload: payload)]
+        var level = 0
+        while level < pending.count && !pending[level].entries.isEmpty {
+            let merged = pending[level]
+            carry.reserveCapacity(carry.count + merged.entries.count)
+            for (i, e) in merged.entries.enumerated() where !merged.dead.contains(i) {
+                carry.append(e)
+            }
+            pendingCount -= merged.entries.count
+            deadCount -= merged.dead.count
+            pending[level] = Tree()
+            level += 1
+        }
+        if level == pending.count {
+            pending.append(Tree())
+        }
+        build(&carry, 0, carry.count, 0)
+        pendingCount += carry.count
+        pending[level] = Tree(entries: carry)
+        count += 1
+        rebuildIfNeeded()
+    }
+
+    /// Adds a point unless one with the same coordinates is already present.
+    @discardableResult
+    func insertUnique(_ point: GLMapPoint) -> Bool {
+        if contains(point) { return false }
+        insert(point)
+        return true
+    }
+
+    /// Removes one occurrence of the point.
+    @discardableResult
+    func remove(_ point: GLMapPoint) -> Bool {
+        return remove(point) { _ in true }
+    }
+
+    /// Removes the entry with this payload at `point`, other entries at the same coordinates stay.
+    @discardableResult
+    func remove(payload: UInt64, at point: GLMapPoint) -> Bool {
+        return remove(point) { $0.payload == payload }
+    }
+
+    private func remove(_ point: GLMapPoint, where match: (Entry) -> Bool) -> Bool {
+        for level in pending.indices {
+            if let i = find(pending[level], point, 0, pending[level].entries.count, 0, match) {
+                pending[level].dead.insert(i)
+                deadCount += 1
+                count -= 1
+                rebuildIfNeeded()
+                return true
+            }
+        }
+        guard let i = find(tree, point, 0, tree.entries.count, 0, match) else { return false }
+        tree.dead.insert(i)
+        deadCount += 1
+        count -= 1
+        rebuildIfNeeded()
+        return true
+    }
+
+    /// Removes one occurrence of each of `points` and returns how many were found.
+    ///
+    /// Small batches are tombstoned one by one. Large ones are matched in a single hashed pass over
+    /// the storage followed by one rebuild.
+    @discardableResult
+    func remove(contentsOf points: [GLMapPoint]) -> Int {
+        if points.count <= max(64, count / 8) {
+            var removed = 0
+            for point in points where remove(point) {
+                removed += 1
+            }
+            return removed
+        }
+
+        var toRemove: [PointKey: Int] = [:]
+        toRemove.reserveCapacity(points.count)
+        for point in points {
+            toRemove[PointKey(point), default: 0] += 1
+        }
+        let before = count
+        rebuild { e in
+            let key = PointKey(e.point)
+            guard let left = toRemove[key] else { return true }
+            toRemove[key] = left > 1 ? left - 1 : nil
+            return false
+        }
+        return before - count
+    }
+
+    func contains(_ point: GLMapPoint) -> Bool {
+        for level in pending where find(level, point, 0, level.entries.count, 0, { _ in true }) != nil {
+            return true
+        }
+        return find(tree, point, 0, tree.entries.count, 0, { _ in true }) != nil
+    }
+
+    // MARK: Queries
+
+    /// Nearest point, same as `GLMapPointSetNearestPoint` but `nil` for an empty set.
+    func nearest(to point: GLMapPoint) -> GLMapPoint? {
+        return nearestItems(to: point, k: 1).first?.point
+    }
+
+    /// Up to `k` points closest to `point`, nearest first.
+    func nearest(to point: GLMapPoint, k: Int) -> [GLMapPoint] {
+        return nearestItems(to: point, k: k).map { $0.point }
+    }
+
+    func nearestItem(to point: GLMapPoint) -> Item? {
+        return nearestItems(to: point, k: 1).first
+    }
+
+    func nearestItems(to point: GLMapPoint, k: Int) -> [Item] {
+        guard k > 0, count > 0 else { return [] }
+        var heap = NeighbourHeap(capacity: k)
+        searchNearest(tree, 0, point, 0, tree.entries.count, 0, &heap)
+        for (level, pendingTree) in pending.enumerated() where !pendingTree.entries.isEmpty {
+            // Pending entries are tagged with negative indices carrying their level.
+            searchNearest(pendingTree, -1 - level << 32, point, 0, pendingTree.entries.count, 0, &heap)
+        }
+        return heap.sorted().map { i in
+            let e = i >= 0 ? tree.entries[i] : pending[(-1 - i) >> 32].entries[(-1 - i) & 0xFFFF_FFFF]
+            return Item(point: e.point, payload: e.payload)
+        }
+    }
+
+    /// Calls `body` for every point not farther than `radius` map units from `center`.
+    func forEach(within radius: Double, of center: GLMapPoint, _ body: (GLMapPoint) -> Void) {
+        forEachItem(within: radius, of: center) { body($0.point) }
+    }
+
+    func forEachItem(within radius: Double, of center: GLMapPoint, _ body: (Item) -> Void) {
+        let r2 = radius * radius
+        searchRadius(tree, center, radius, r2, 0, tree.entries.count, 0, body)
+        for level in pending where !level.entries.isEmpty {
+            searchRadius(level, center, radius, r2, 0, level.entries.count, 0, body)
+        }
+    }
+
+    /// Points not farther than `meters` from `center`. The radius is converted with the Mercator scale at `center`.
+    func points(withinMeters meters: Double, of center: GLMapPoint) -> [GLMapPoint] {
+        return items(withinMeters: meters, of: center).map { $0.point }
+    }
+
+    func items(withinMeters meters: Double, of center: GLMapPoint) -> [Item] {
+        var result: [Item] = []
+        forEachItem(within: meters * MapPointIndex.mapUnitsPerMeter(at: center), of: center) { result.append($0) }
+        return result
+    }
+
+    static func mapUnitsPerMeter(at point: GLMapPoint) -> Double {
+        let probe = 1024.0
+        return probe / point.distanceTo(point.add(x: probe, y: 0))
+    }
+
+    // MARK: Tree
+
+    private func rebuildIfNeeded() {
+        let limit = max(64, tree.entries.count / 8)
+        if pendingCount > limit || deadCount > limit {
+            rebuild { _ in true }
+        }
+    }
+
+    /// Gathers the live entries that `keep` accepts into a fresh main tree. The old arrays are left
+    /// untouched for copies that still share them.
+    private func rebuild(keeping keep: (Entry) -> Bool) {
+        var entries: [Entry] = []
+        entries.reserveCapacity(count)
+        for level in [tree] + pending {
+            for (i, e) in level.entries.enumerated() where !level.dead.contains(i) && keep(e) {
+                entries.append(e)
+            }
+        }
+        build(&entries, 0, entries.count, 0)
+        tree = Tree(entries: entries)
+        pending.removeAll()
+        pendingCount = 0
+        deadCount = 0
+        count = entries.count
+    }
+
+    private func build(_ entries: inout [Entry], _ lo: Int, _ hi: Int, _ axis: Int) {
+        if hi - lo <= 1 { return }
+        let mid = (lo + hi) / 2
+        select(&entries, lo, hi, mid, axis)
+        build(&entries, lo, mid, axis ^ 1)
+        build(&entries, mid + 1, hi, axis ^ 1)
+    }
+
+    /// Quickselect: afterwards `entries[k]` is in sorted position along `axis` within `lo..<hi`.
+    private func select(_ entries: inout [Entry], _ lo: Int, _ hi: Int, _ k: Int, _ axis: Int) {
+        var lo = lo, hi = hi - 1
+        while lo < hi {
+            let pivot = coordinate(entries[(lo + hi) / 2].point, axis)
+            var i = lo, j = hi
+            while i <= j {
+                while coordinate(entries[i].point, axis) < pivot { i += 1 }
+                while coordinate(entries[j].point, axis) > pivot { j -= 1 }
+                if i <= j {
+                    entries.swapAt(i, j)
+                    i += 1
+                    j -= 1
+                }
+            }
+            if k <= j {
+                hi = j
+            } else if k >= i {
+                lo = i
+            } else {
+                return
+            }
+        }
+    }
+
+    private func find(_ tree: Tree, _ point: GLMapPoint, _ lo: Int, _ hi: Int, _ axis: Int, _ match: (Entry) -> Bool) -> Int? {
+        if lo >= hi { return nil }
+        let mid = (lo + hi) / 2
+        let e = tree.entries[mid]
+        if GLMapPointEqual(e.point, point) && !tree.dead.contains(mid) && match(e) { return mid }
+        let q = coordinate(point, axis), p = coordinate(e.point, axis)
+        if q <= p, let i = find(tree, point, lo, mid, axis ^ 1, match) { return i }
+        if q >= p, let i = find(tree, point, mid + 1, hi, axis ^ 1, match) { return i }
+        return nil
+    }
+
+    /// Offers entries to `heap` as `tag + index` for the main tree, `tag - index` for pending trees.
+    private func searchNearest(_ tree: Tree, _ tag: Int, _ point: GLMapPoint, _ lo: Int, _ hi: Int, _ axis: Int, _ heap: inout NeighbourHeap) {
+        if lo >= hi { return }
+        let mid = (lo + hi) / 2
+        let e = tree.entries[mid]
+        if !tree.dead.contains(mid) {
+            heap.offer(distanceSquared(e.point, point), tag >= 0 ? tag + mid : tag - mid)
+        }
+        let diff = coordinate(point, axis) - coordinate(e.point, axis)
+        let (nearLo, nearHi, farLo, farHi) = diff <= 0 ? (lo, mid, mid + 1, hi) : (mid + 1, hi, lo, mid)
+        searchNearest(tree, tag, point, nearLo, nearHi, axis ^ 1, &heap)
+        if diff * diff <= heap.bound {
+            searchNearest(tree, tag, point, farLo, farHi, axis ^ 1, &heap)
+        }
+    }
+
+    private func searchRadius(_ tree: Tree, _ center: GLMapPoint, _ radius: Double, _ r2: Double, _ lo: Int, _ hi: Int, _ axis: Int, _ body: (Item) -> Void) {
+        if lo >= hi { return }
+        let mid = (lo + hi) / 2
+        let e = tree.entries[mid]
+        if distanceSquared(e.point, center) <= r2 && !tree.dead.contains(mid) {
+            body(Item(point: e.point, payload: e.payload))
+        }
+        let diff = coordinate(center, axis) - coordinate(e.point, axis)
+        if diff <= radius {
+            searchRadius(tree, center, radius, r2, lo, mid, axis ^ 1, body)
+        }
+        if diff >= -radius {
+            searchRadius(tree, center, radius, r2, mid + 1, hi, axis ^ 1, body)
+        }
+    }
+}
+
+/// Removed positions of one tree as a bitset split into 4096-bit chunks. Chunks are allocated on first
+/// use, and a copy shares every chunk it does not write to.
+private struct Tombstones {
+    private var chunks: [[UInt64]] = []
+    private(set) var count = 0
+
+    @inline(__always)
+    func contains(_ i: Int) -> Bool {
+        let c = i >> 12
+        guard c < chunks.count, !chunks[c].isEmpty else { return false }
+        return chunks[c][(i >> 6) & 63] & (1 << UInt64(i & 63)) != 0
+    }
+
+    mutating func insert(_ i: Int) {
+        let c = i >> 12
+        if c >= chunks.count {
+            chunks += repeatElement([], count: c + 1 - chunks.count)
+        }
+        if chunks[c].isEmpty {
+            chunks[c] = [UInt64](repeating: 0, count: 64)
+        }
+        let bit: UInt64 = 1 << UInt64(i & 63)
+        if chunks[c][(i >> 6) & 63] & bit == 0 {
+            chunks[c][(i >> 6) & 63] |= bit
+            count += 1
+        }
+    }
+}
+
+/// Exact-coordinate hash key, `GLMapPoint` itself is not `Hashable`.
+private struct PointKey: Hashable {
+    let x: UInt64
+    let y: UInt64
+
+    init(_ p: GLMapPoint) {
+        x = p.x.bitPattern
+        y = p.y.bitPattern
+    }
+}
+
+@inline(__always)
+private func coordinate(_ p: GLMapPoint, _ axis: Int) -> Double {
+    return axis == 0 ? p.x : p.y
+}
+
+@inline(__always)
+func distanceSquared(_ a: GLMapPoint, _ b: GLMapPoint) -> Double {
+    let dx = a.x - b.x, dy = a.y - b.y
+    return dx * dx + dy * dy
+}
+
+/// Bounded max-heap keeping the `capacity` smallest distances seen.
+struct NeighbourHeap {
+    private var items: [(d2: Double, index: Int)] = []
+    let capacity: Int
+
+    init(capacity: Int) {
+        self.capacity = capacity
+        items.reserveCapacity(capacity)
+    }
+
+    /// Squared distance a candidate has to beat to get in.
+    var bound: Double {
+        return items.count < capacity ? .infinity : items[0].d2
+    }
+
+    mutating func offer(_ d2: Double, _ index: Int) {
+        if items.count < capacity {
+            items.append((d2, index))
+            var i = items.count - 1
+            while i > 0 {
+                let parent = (i - 1) / 2
+                if items[parent].d2 >= items[i].d2 { break }
+                items.swapAt(parent, i)
+                i = parent
+            }
+        } else if d2 < items[0].d2 {
+            items[0] = (d2, index)
+            var i = 0
+            while true {
+                let l = 2 * i + 1, r = l + 1
+                var largest = i
+                if l < items.count && items[l].d2 > items[largest].d2 { largest = l }
+                if r < items.count && items[r].d2 > items[largest].d2 { largest = r }
+                if largest == i { break }
+                items.swapAt(i, largest)
+                i = largest
+            }
+        }
+    }
+
+    /// Indices ordered from nearest to farthest.
+    func sorted() -> [Int] {
+        return items.sorted { $0.d2 < $1.d2 }.map { $0.index }
+    }
+}
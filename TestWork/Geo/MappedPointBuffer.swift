@@ -0,0 +1,109 @@
+//
+//  MappedPointBuffer.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Read-only run of `GLMapPoint` that the app does not copy: a memory-mapped file of raw points or a
+/// caller-owned buffer adopted with a deallocation callback.
+///
+/// Framework objects are built straight from the mapped pages, so a large archive is copied once, into
+/// the framework's own storage, instead of first into a Swift array and then again into the object.
+final class MappedPointBuffer {
+    private let base: UnsafePointer<GLMapPoint>?
+    private let release: () -> Void
+
+    let count: Int
+
+    var points: UnsafeBufferPointer<GLMapPoint> { UnsafeBufferPointer(start: base, count: count) }
+
+    /// Adopts `count` points at `points`. They must stay valid and unchanged until `deallocator` is called.
+    init(adopting points: UnsafePointer<GLMapPoint>, count: Int, deallocator: (() -> Void)? = nil) {
+        base = points
+        self.count = count
+        release = deallocator ?? {}
+    }
+
+    /// Maps `count` points starting `offset` bytes into the file, or the whole file after `offset` when
+    /// `count` is nil. Fails if the file cannot be mapped or is shorter than requested.
+    init?(contentsOf url: URL, offset: Int = 0, count: Int? = nil) {
+        let stride = MemoryLayout<GLMapPoint>.stride
+        guard offset >= 0, offset % MemoryLayout<Double>.alignment == 0 else { return nil }
+        let fd = open(url.path, O_RDONLY)
+        guard fd >= 0 else { return nil }
+        defer { close(fd) }
+
+        var info = stat()
+        guard fstat(fd, &info) == 0 else { return nil }
+        let available = (Int(info.st_size) - offset) / stride
+        let n = count ?? available
+        guard n >= 0, n <= available else { return nil }
+        self.count = n
+        guard n > 0 else {
+            base = nil
+            release = {}
+            return
+        }
+
+        // mmap wants a page-aligned file offset, so map from the page start and skip the remainder.
+        let page = Int(getpagesize())
+        let mapOffset = offset / page * page
+        let length = offset - mapOffset + n * stride
+        guard let mapped = mmap(nil, length, PROT_READ, MAP_PRIVATE, fd, off_t(mapOffset)),
+              mapped != MAP_FAILED else { return nil }
+        madvise(mapped, length, MADV_SEQUENTIAL)
+        base = UnsafeRawPointer(mapped).advanced(by: offset - mapOffset).assumingMemoryBound(to: GLMapPoint.self)
+        release = { munmap(mapped, length) }
+    }
+
+    deinit {
+        release()
+    }
+
+    subscript(index: Int) -> GLMapPoint {
+        return points[index]
+    }
+
+    // MARK: Framework objects
+
+    /// `GLMapPointArray` over `range`, filled from the mapped pages in one bulk copy.
+    func makePointArray(_ range: Range<Int>? = nil) -> GLMapPointArray {
+        let r = range ?? 0..<count
+        guard let base = base, !r.isEmpty else { return GLMapPointArray() }
+        return GLMapPointArray(points: UnsafeMutablePointer(mutating: base + r.lowerBound), count: UInt(r.count))
+    }
+
+    /// Track over `range` with a single color, points are read from the mapped pages on demand.
+    func makeTrackData(color: GLMapColor, _ range: Range<Int>? = nil) -> GLMapTrackData? {
+        let r = range ?? 0..<count
+        guard let base = base, !r.isEmpty else { return nil }
+        let start = base + r.lowerBound
+        return GLMapTrackData(pointsCallback: { i, pt in
+            pt.pointee = GLTrackPoint(pt: start[Int(i)], color: color)
+            return true
+        }, count: UInt(r.count))
+    }
+
+    /// Deinterleaved copy for the column kernels; the file layout is interleaved, so this one has to copy.
+    func makeColumns() -> MapPointColumns {
+        return MapPointColumns(points)
+    }
+
+    // MARK: Writing
+
+    /// Writes raw points in the layout `init?(contentsOf:)` maps.
+    @discardableResult
+    static func write(_ points: UnsafeBufferPointer<GLMapPoint>, to url: URL) -> Bool {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil),
+              let handle = FileHandle(forWritingAtPath: url.path) else { return false }
+        defer { handle.closeFile() }
+        if let base = points.baseAddress {
+            handle.write(Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: base), count: points.count * MemoryLayout<GLMapPoint>.stride, deallocator: .none))
+        }
+        return true
+    }
+}
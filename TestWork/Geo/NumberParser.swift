@@ -0,0 +1,148 @@
+//
+//  NumberParser.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Batch parsing of separator-delimited numbers, such as GeoJSON coordinate arrays and CSV location feeds,
+/// on top of `ParseDouble` / `ParseFloat`.
+///
+/// Value ends are found 64 bytes at a time with SIMD compares that mark every byte that cannot be part of
+/// a number, so each value is handed to fast_float with its exact length instead of the rest of the input.
+enum NumberParser {
+    /// Parses up to `out.count` values separated by `separator` from the start of `bytes`. Whitespace around
+    /// values is skipped. Stops at the first byte that is not part of a value, whitespace or a separator, or
+    /// at a malformed value; `consumed` is the offset of that byte, or of the next value when `out` is full.
+    static func parseDoubles(_ bytes: UnsafeRawBufferPointer, separator: UInt8 = UInt8(ascii: ","),
+                             into out: UnsafeMutableBufferPointer<Double>) -> (count: Int, consumed: Int) {
+        return parse(bytes, separator, out, ParseDouble)
+    }
+
+    static func parseFloats(_ bytes: UnsafeRawBufferPointer, separator: UInt8 = UInt8(ascii: ","),
+                            into out: UnsafeMutableBufferPointer<Float>) -> (count: Int, consumed: Int) {
+        return parse(bytes, separator, out, ParseFloat)
+    }
+
+    /// All leading values of `data`.
+    static func doubles(in data: Data, separator: UInt8 = UInt8(ascii: ",")) -> [Double] {
+        var result: [Double] = []
+        var chunk = [Double](repeating: 0, count: 4096)
+        data.withUnsafeBytes { bytes in
+            var offset = 0
+            while true {
+                let (n, consumed) = chunk.withUnsafeMutableBufferPointer {
+                    parseDoubles(UnsafeRawBufferPointer(rebasing: bytes[offset...]), separator: separator, into: $0)
+                }
+                result += chunk[0..<n]
+                offset += consumed
+                guard n == chunk.count else { break }
+            }
+        }
+        return result
+    }
+
+    // MARK: Parsing
+
+    private typealias ParseFunction<T> = (UnsafeMutablePointer<UnsafePointer<CChar>>, UInt32, UnsafeMutablePointer<T>) -> Bool
+
+    private static func parse<T>(_ bytes: UnsafeRawBufferPointer, _ separator: UInt8, _ out: UnsafeMutableBufferPointer<T>,
+                                 _ parseValue: ParseFunction<T>) -> (count: Int, consumed: Int) {
+        guard let base = bytes.baseAddress?.assumingMemoryBound(to: CChar.self), let result = out.baseAddress else { return (0, 0) }
+        var scanner = TerminatorScanner(bytes: bytes)
+        var pos = 0, count = 0
+        while count < out.count {
+            var start = pos
+            while start < bytes.count && isSpace(bytes[start]) {
+                start += 1
+            }
+            let end = scanner.next(from: start)
+            guard end > start else { break }
+            var p = UnsafePointer(base + start)
+            guard parseValue(&p, UInt32(end - start), result + count), p == UnsafePointer(base + end) else { break }
+            count += 1
+
+            var next = end
+            while next < bytes.count && isSpace(bytes[next]) {
+                next += 1
+            }
+            pos = next
+            if next < bytes.count && bytes[next] == separator {
+                pos = next + 1
+            } else if !(isSpace(separator) && next > end) {
+                break
+            }
+        }
+        return (count, pos)
+    }
+
+    static func isSpace(_ b: UInt8) -> Bool {
+        return b == 0x20 || b == 0x0A || b == 0x0D || b == 0x09
+    }
+
+    fileprivate static func isNumberByte(_ b: UInt8) -> Bool {
+        return b &- 0x30 < 10 || b == 0x2E || b == 0x2D || b == 0x2B || b | 0x20 == 0x65
+    }
+}
+
+/// Bitmask of bytes that end a value, one 64-byte block at a time. Bytes past the end count as ends.
+private struct TerminatorScanner {
+    let bytes: UnsafeRawBufferPointer
+    private var blockStart = -1
+    private var mask: UInt64 = 0
+
+    init(bytes: UnsafeRawBufferPointer) {
+        self.bytes = bytes
+    }
+
+    /// Offset of the first byte at or after `i` that cannot be part of a number.
+    mutating func next(from i: Int) -> Int {
+        var i = i
+        while i < bytes.count {
+            let block = i & ~63
+            if block != blockStart {
+                mask = TerminatorScanner.mask(bytes, block)
+                blockStart = block
+            }
+            let m = mask >> UInt64(i - block)
+            if m != 0 {
+                return min(i + m.trailingZeroBitCount, bytes.count)
+            }
+            i = block + 64
+        }
+        return bytes.count
+    }
+
+    private static func mask(_ bytes: UnsafeRawBufferPointer, _ start: Int) -> UInt64 {
+        var m: UInt64 = 0
+        guard start + 64 <= bytes.count else {
+            for k in 0..<64 where start + k >= bytes.count || !NumberParser.isNumberByte(bytes[start + k]) {
+                m |= 1 << UInt64(k)
+            }
+            return m
+        }
+        for lane in 0..<4 {
+            let v = bytes.loadUnaligned(fromByteOffset: start + 16 * lane, as: SIMD16<UInt8>.self)
+            m |= UInt64(terminators(v)) << UInt64(16 * lane)
+        }
+        return m
+    }
+
+    /// Movemask of the lanes that are not a digit, '.', '-', '+', 'e' or 'E'.
+    private static func terminators(_ v: SIMD16<UInt8>) -> UInt16 {
+        let number = ((v &- 0x30) .< 10) .| (v .== 0x2E) .| (v .== 0x2D) .| (v .== 0x2B) .| ((v | 0x20) .== 0x65)
+        return (.!number).bits
+    }
+}
+
+extension SIMDMask where Storage == SIMD16<Int8> {
+    /// One bit per lane, lane 0 in the lowest bit, like SSE movemask.
+    var bits: UInt16 {
+        let weights = SIMD16<UInt8>(1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128)
+        let set = SIMD16<UInt8>(repeating: 0).replacing(with: weights, where: self)
+        return UInt16(set.lowHalf.wrappingSum()) | UInt16(set.highHalf.wrappingSum()) << 8
+    }
+}
@@ -0,0 +1,115 @@
+//
+//  ScreenBBoxGrid.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Collision set for small screen-space boxes such as labels and markers, rebuilt every frame.
+///
+/// A fixed uniform grid over the screen with per-cell linked lists kept in flat arrays. Cells are
+/// invalidated by a generation counter, so `reset()` is O(1) and test/insert touch only the few cells a
+/// label covers. Boxes outside the screen are clamped to the border cells.
+final class ScreenBBoxGrid {
+    private let cellSize: Double
+    private let columns: Int
+    private let rows: Int
+
+    private var generation: UInt32 = 1
+    private var cellGeneration: [UInt32]
+    private var cellHead: [Int32]
+
+    private var boxes: [GLMapBBox] = []
+    private var nodeBox: [Int32] = []
+    private var nodeNext: [Int32] = []
+
+    var count: Int { boxes.count }
+
+    init(width: Double, height: Double, cellSize: Double = 32) {
+        self.cellSize = cellSize
+        columns = max(1, Int((width / cellSize).rounded(.up)))
+        rows = max(1, Int((height / cellSize).rounded(.up)))
+        cellGeneration = Array(repeating: 0, count: columns * rows)
+        cellHead = Array(repeating: -1, count: columns * rows)
+    }
+
+    convenience init(size: CGSize, cellSize: Double = 32) {
+        self.init(width: Double(size.width), height: Double(size.height), cellSize: cellSize)
+    }
+
+    /// Forgets all boxes without touching the cells.
+    func reset() {
+        generation &+= 1
+        if generation == 0 {
+            for i in 0..<cellGeneration.count {
+                cellGeneration[i] = 0
+            }
+            generation = 1
+        }
+        boxes.removeAll(keepingCapacity: true)
+        nodeBox.removeAll(keepingCapacity: true)
+        nodeNext.removeAll(keepingCapacity: true)
+    }
+
+    /// Same as `GLMapBBoxSetTest`: true if `bbox` intersects any inserted box.
+    func test(_ bbox: GLMapBBox) -> Bool {
+        // A negative-size box can never intersect anything, even when both corners clamp to one cell.
+        guard bbox.size.x >= 0 && bbox.size.y >= 0 else { return false }
+        let (x0, y0, x1, y1) = cellRange(bbox)
+        for y in y0...y1 {
+            for x in x0...x1 {
+                let c = y * columns + x
+                guard cellGeneration[c] == generation else { continue }
+                var node = cellHead[c]
+                while node >= 0 {
+                    if boxes[Int(nodeBox[Int(node)])].intersects(bbox: bbox) {
+                        return true
+                    }
+                    node = nodeNext[Int(node)]
+                }
+            }
+        }
+        return false
+    }
+
+    /// Negative-size boxes are ignored.
+    func insert(_ bbox: GLMapBBox) {
+        guard bbox.size.x >= 0 && bbox.size.y >= 0 else { return }
+        let (x0, y0, x1, y1) = cellRange(bbox)
+        let index = Int32(boxes.count)
+        boxes.append(bbox)
+        for y in y0...y1 {
+            for x in x0...x1 {
+                let c = y * columns + x
+                if cellGeneration[c] != generation {
+                    cellGeneration[c] = generation
+                    cellHead[c] = -1
+                }
+                nodeBox.append(index)
+                nodeNext.append(cellHead[c])
+                cellHead[c] = Int32(nodeBox.count - 1)
+            }
+        }
+    }
+
+    /// Inserts `bbox` only if it does not collide, the usual label placement step.
+    @discardableResult
+    func insertIfFree(_ bbox: GLMapBBox) -> Bool {
+        if test(bbox) { return false }
+        insert(bbox)
+        return true
+    }
+
+    private func cellRange(_ bbox: GLMapBBox) -> (Int, Int, Int, Int) {
+        return (cell(bbox.origin.x, columns), cell(bbox.origin.y, rows),
+                cell(bbox.origin.x + bbox.size.x, columns), cell(bbox.origin.y + bbox.size.y, rows))
+    }
+
+    private func cell(_ v: Double, _ limit: Int) -> Int {
+        guard v > 0 else { return 0 }
+        return Int(min(v / cellSize, Double(limit - 1)))
+    }
+}
@@ -0,0 +1,317 @@
+//
+//  Simplifier.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+enum SimplifyMode {
+    /// Ramer–Douglas–Peucker, `tolerance` is the maximum distance in map units.
+    case douglasPeucker(tolerance: Double)
+    /// Visvalingam–Whyatt, removes points whose effective triangle area is below `minArea` square map units.
+    case visvalingam(minArea: Double)
+    /// Visvalingam–Whyatt down to `count` points, the smoothest result for a fixed point budget.
+    case visvalingamCount(Int)
+}
+
+/// Line and polygon simplification with a choice of algorithm.
+///
+/// Visvalingam–Whyatt runs on an indexed min-heap of effective areas, O(n log n). For rings it can also
+/// preserve topology: a point is only removed when no other vertex lies in the triangle it cuts off,
+/// which is enough to guarantee the shortcut crosses no edge of any ring when the input has no crossings.
+enum Simplifier {
+    // MARK: Lines
+
+    /// Indices of the points kept from an open line. The first and last points are always kept.
+    static func indices(_ points: [GLMapPoint], mode: SimplifyMode) -> [Int] {
+        guard points.count > 2 else { return Array(points.indices) }
+        switch mode {
+        case .douglasPeucker(let tolerance):
+            return douglasPeucker(points, tolerance)
+        case .visvalingam, .visvalingamCount:
+            var engine = Visvalingam(rings: [points], closed: false, topology: false)
+            engine.run(mode)
+            return engine.kept()[0]
+        }
+    }
+
+    static func simplify(_ points: [GLMapPoint], mode: SimplifyMode) -> [GLMapPoint] {
+        return indices(points, mode: mode).map { points[$0] }
+    }
+
+    static func simplify(_ points: [GLTrackPoint], mode: SimplifyMode) -> [GLTrackPoint] {
+        return indices(points.map { $0.pt }, mode: mode).map { points[$0] }
+    }
+
+    // MARK: Polygons
+
+    /// Simplifies closed rings together. A repeated closing point is accepted and kept in the output;
+    /// rings never drop below three distinct points. Topology is preserved for the Visvalingam modes when
+    /// `preserveTopology` is set; Douglas–Peucker rings are simplified independently.
+    static func simplifyRings(_ rings: [[GLMapPoint]], mode: SimplifyMode, preserveTopology: Bool = true) -> [[GLMapPoint]] {
+        let open = rings.map { ring -> [GLMapPoint] in
+            ring.count > 1 && GLMapPointEqual(ring[0], ring[ring.count - 1]) ? Array(ring.dropLast()) : ring
+        }
+        var result: [[GLMapPoint]]
+        switch mode {
+        case .douglasPeucker(let tolerance):
+            result = open.map { ring in
+                guard ring.count > 3 else { return ring }
+                // Split the ring at the point farthest from the first one and simplify both halves.
+                var far = 1, farDistance = 0.0
+                for j in 1..<ring.count {
+                    let dx = ring[j].x - ring[0].x, dy = ring[j].y - ring[0].y
+                    if dx * dx + dy * dy > farDistance {
+                        far = j
+                        farDistance = dx * dx + dy * dy
+                    }
+                }
+                let first = douglasPeucker(Array(ring[0...far]), tolerance)
+                let second = douglasPeucker(Array(ring[far...]) + [ring[0]], tolerance).map { $0 + far }
+                let kept = first + second.dropFirst().filter { $0 < ring.count }
+                return kept.count >= 3 ? kept.map { ring[$0] } : ring
+            }
+        case .visvalingam, .visvalingamCount:
+            var engine = Visvalingam(rings: open, closed: true, topology: preserveTopology)
+            engine.run(mode)
+            result = zip(engine.kept(), open).map { indices, ring in indices.map { ring[$0] } }
+        }
+        for i in 0..<result.count where rings[i].count > 1 && GLMapPointEqual(rings[i][0], rings[i][rings[i].count - 1]) {
+            result[i].append(result[i][0])
+        }
+        return result
+    }
+
+    /// Simplified `GLMapVectorPolygon`, outer and inner rings are simplified together so holes stay inside.
+    static func polygon(outerRings: [[GLMapPoint]], innerRings: [[GLMapPoint]] = [], mode: SimplifyMode, preserveTopology: Bool = true) -> GLMapVectorPolygon {
+        let rings = simplifyRings(outerRings + innerRings, mode: mode, preserveTopology: preserveTopology)
+        let arrays = rings.map { ring in GLMapPointArray(count: UInt(ring.count)) { ring[Int($0)] } }
+        let inner = Array(arrays[outerRings.count...])
+        return GLMapVectorPolygon(Array(arrays[..<outerRings.count]), innerRings: inner.isEmpty ? nil : inner)
+    }
+
+    // MARK: Douglas–Peucker
+
+    private static func douglasPeucker(_ points: [GLMapPoint], _ tolerance: Double) -> [Int] {
+        let n = points.count
+        guard n > 2 else { return Array(0..<n) }
+        var keep = [Bool](repeating: false, count: n)
+        keep[0] = true
+        keep[n - 1] = true
+        let tolerance2 = tolerance * tolerance
+        var stack = [(0, n - 1)]
+        while let (lo, hi) = stack.popLast() {
+            guard hi - lo > 1 else { continue }
+            var best = -1.0, bestIndex = lo
+            for i in (lo + 1)..<hi {
+                let d = segmentDistanceSquared(points[i], points[lo], points[hi])
+                if d > best {
+                    best = d
+                    bestIndex = i
+                }
+            }
+            if best > tolerance2 {
+                keep[bestIndex] = true
+                stack.append((lo, bestIndex))
+                stack.append((bestIndex, hi))
+            }
+        }
+        return keep.indices.filter { keep[$0] }
+    }
+
+    private static func segmentDistanceSquared(_ p: GLMapPoint, _ a: GLMapPoint, _ b: GLMapPoint) -> Double {
+        let abx = b.x - a.x, aby = b.y - a.y
+        var dx = p.x - a.x, dy = p.y - a.y
+        let len2 = abx * abx + aby * aby
+        if len2 > 0 {
+            let t = min(max((dx * abx + dy * aby) / len2, 0), 1)
+            dx -= t * abx
+            dy -= t * aby
+        }
+        return dx * dx + dy * dy
+    }
+
+    // MARK: Visvalingam–Whyatt
+
+    /// All rings in flat arrays with prev/next links, so removals are O(1) plus the heap update.
+    private struct Visvalingam {
+        private var points: [GLMapPoint] = []
+        private var prev: [Int] = []
+        private var next: [Int] = []
+        private var ring: [Int] = []
+        private var fixed: [Bool] = []
+        private var alive: [Bool] = []
+        private var ringStart: [Int] = []
+        private var ringLive: [Int] = []
+        private let ringMin: Int
+        private var live = 0
+
+        private var heap: [Int] = []
+        private var position: [Int] = []
+        private var area: [Double] = []
+
+        /// Live vertices for the topology test. All are inserted before any removal, so ids equal indices.
+        private let vertices: MapBBoxIndex?
+
+        init(rings: [[GLMapPoint]], closed: Bool, topology: Bool) {
+            ringMin = closed ? 3 : 2
+            vertices = topology ? MapBBoxIndex() : nil
+            for (r, pts) in rings.enumerated() {
+                let start = points.count
+                ringStart.append(start)
+                ringLive.append(pts.count)
+                for (i, p) in pts.enumerated() {
+                    points.append(p)
+                    ring.append(r)
+                    alive.append(true)
+                    prev.append(i > 0 ? start + i - 1 : (closed ? start + pts.count - 1 : -1))
+                    next.append(i + 1 < pts.count ? start + i + 1 : (closed ? start : -1))
+                    fixed.append(!closed && (i == 0 || i == pts.count - 1))
+                }
+            }
+            live = points.count
+            for p in points {
+                vertices?.insert(GLMapBBox(origin: p, width: 0, height: 0))
+            }
+            area = (0..<points.count).map { fixed[$0] || ringLive[ring[$0]] <= ringMin ? .infinity : triangleArea($0) }
+            position = Array(repeating: -1, count: points.count)
+            for i in 0..<points.count where area[i] < .infinity {
+                position[i] = heap.count
+                heap.append(i)
+            }
+            for i in stride(from: heap.count / 2 - 1, through: 0, by: -1) {
+                siftDown(i)
+            }
+        }
+
+        mutating func run(_ mode: SimplifyMode) {
+            while let i = heap.first, area[i] < .infinity {
+                switch mode {
+                case .visvalingam(let minArea) where area[i] >= minArea:
+                    return
+                case .visvalingamCount(let count) where live <= count:
+                    return
+                default:
+                    break
+                }
+                if ringLive[ring[i]] <= ringMin {
+                    setArea(i, .infinity)
+                    continue
+                }
+                if vertices != nil && blocked(i) {
+                    setArea(i, .infinity)
+                    continue
+                }
+                remove(i)
+            }
+        }
+
+        func kept() -> [[Int]] {
+            return ringStart.indices.map { r in
+                let start = ringStart[r]
+                let end = r + 1 < ringStart.count ? ringStart[r + 1] : points.count
+                return (start..<end).filter { alive[$0] }.map { $0 - start }
+            }
+        }
+
+        private mutating func remove(_ i: Int) {
+            let removedArea = area[i]
+            let p = prev[i], n = next[i]
+            alive[i] = false
+            next[p] = n
+            prev[n] = p
+            live -= 1
+            ringLive[ring[i]] -= 1
+            vertices?.remove(i)
+            popMin()
+            // Effective area never decreases, so a neighbour is not removed before the point it replaced.
+            for j in [p, n] where !fixed[j] && position[j] >= 0 {
+                setArea(j, max(triangleArea(j), removedArea))
+            }
+        }
+
+        /// True if some other vertex lies in the triangle that removing `i` would cut off.
+        private func blocked(_ i: Int) -> Bool {
+            guard let vertices = vertices else { return false }
+            let a = points[prev[i]], b = points[i], c = points[next[i]]
+            let minX = min(a.x, b.x, c.x), minY = min(a.y, b.y, c.y)
+            let box = GLMapBBox(origin: GLMapPoint(x: minX, y: minY), width: max(a.x, b.x, c.x) - minX, height: max(a.y, b.y, c.y) - minY)
+            var hit = false
+            vertices.query(box) { j in
+                guard !hit, j != i, j != prev[i], j != next[i] else { return }
+                hit = inTriangle(points[j], a, b, c)
+            }
+            return hit
+        }
+
+        private func triangleArea(_ i: Int) -> Double {
+            let a = points[prev[i]], b = points[i], c = points[next[i]]
+            return abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2
+        }
+
+        private func inTriangle(_ p: GLMapPoint, _ a: GLMapPoint, _ b: GLMapPoint, _ c: GLMapPoint) -> Bool {
+            let d1 = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)
+            let d2 = (c.x - b.x) * (p.y - b.y) - (c.y - b.y) * (p.x - b.x)
+            let d3 = (a.x - c.x) * (p.y - c.y) - (a.y - c.y) * (p.x - c.x)
+            let negative = d1 < 0 || d2 < 0 || d3 < 0
+            let positive = d1 > 0 || d2 > 0 || d3 > 0
+            return !(negative && positive)
+        }
+
+        // MARK: Heap
+
+        private mutating func setArea(_ i: Int, _ value: Double) {
+            let old = area[i]
+            area[i] = value
+            guard position[i] >= 0 else { return }
+            if value < old {
+                siftUp(position[i])
+            } else {
+                siftDown(position[i])
+            }
+        }
+
+        private mutating func popMin() {
+            let top = heap[0]
+            position[top] = -1
+            let last = heap.removeLast()
+            if !heap.isEmpty {
+                heap[0] = last
+                position[last] = 0
+                siftDown(0)
+            }
+        }
+
+        private mutating func siftUp(_ k: Int) {
+            var k = k
+            while k > 0 {
+                let parent = (k - 1) / 2
+                guard area[heap[k]] < area[heap[parent]] else { break }
+                swapAt(k, parent)
+                k = parent
+            }
+        }
+
+        private mutating func siftDown(_ k: Int) {
+            var k = k
+            while true {
+                let l = 2 * k + 1, r = l + 1
+                var m = k
+                if l < heap.count && area[heap[l]] < area[heap[m]] { m = l }
+                if r < heap.count && area[heap[r]] < area[heap[m]] { m = r }
+                guard m != k else { break }
+                swapAt(k, m)
+                k = m
+            }
+        }
+
+        private mutating func swapAt(_ a: Int, _ b: Int) {
+            heap.swapAt(a, b)
+            position[heap[a]] = a
+            position[heap[b]] = b
+        }
+    }
+}
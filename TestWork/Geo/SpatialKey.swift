@@ -0,0 +1,190 @@
+//
+//  SpatialKey.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Morton (Z-order) and Hilbert keys for map points and tiles, used to sort and shard them in locality order.
+///
+/// Points are quantized to `bits` per axis (1...32) over `0...GLMapPointMax`. Tile keys put the zoom in the
+/// top 6 bits, so tiles of one zoom sort together and zooms up to 29 fit. Tile coordinates outside
+/// `0..<2^z`, such as the negative x of a tile west of the antimeridian, wrap around the world.
+enum SpatialKey {
+    // MARK: Morton
+
+    static func morton(x: UInt32, y: UInt32) -> UInt64 {
+        return spread(x) | spread(y) << 1
+    }
+
+    static func mortonDecode(_ key: UInt64) -> (x: UInt32, y: UInt32) {
+        return (compact(key), compact(key >> 1))
+    }
+
+    static func morton(_ point: GLMapPoint, bits: Int = 32) -> UInt64 {
+        let (x, y) = quantize(point, bits: bits)
+        return morton(x: x, y: y)
+    }
+
+    /// Center of the cell addressed by `key`.
+    static func mortonDecodePoint(_ key: UInt64, bits: Int = 32) -> GLMapPoint {
+        let (x, y) = mortonDecode(key)
+        return dequantize(x, y, bits: bits)
+    }
+
+    static func morton(_ tile: GLMapTilePos) -> UInt64 {
+        let (x, y) = tileCell(tile)
+        return UInt64(tile.z) << 58 | morton(x: x, y: y)
+    }
+
+    static func mortonDecodeTile(_ key: UInt64) -> GLMapTilePos {
+        let (x, y) = mortonDecode(key & (1 << 58 - 1))
+        return GLMapTilePos(x: Int32(x), y: Int32(y), z: Int32(key >> 58))
+    }
+
+    // MARK: Hilbert
+
+    /// Hilbert index of `(x, y)` on a `2^order` grid.
+    static func hilbert(x: UInt32, y: UInt32, order: Int) -> UInt64 {
+        var x = UInt64(x), y = UInt64(y)
+        var d: UInt64 = 0
+        var s: UInt64 = order > 0 ? 1 << UInt64(order - 1) : 0
+        while s > 0 {
+            let rx: UInt64 = (x & s) != 0 ? 1 : 0
+            let ry: UInt64 = (y & s) != 0 ? 1 : 0
+            d += s * s * ((3 * rx) ^ ry)
+            if ry == 0 {
+                if rx == 1 {
+                    x = s &- 1 &- x
+                    y = s &- 1 &- y
+                }
+                swap(&x, &y)
+            }
+            x &= s &- 1
+            y &= s &- 1
+            s >>= 1
+        }
+        return d
+    }
+
+    static func hilbertDecode(_ key: UInt64, order: Int) -> (x: UInt32, y: UInt32) {
+        var x: UInt64 = 0, y: UInt64 = 0
+        var t = key
+        var s: UInt64 = 1
+        let n: UInt64 = order > 0 ? 1 << UInt64(order) : 1
+        while s < n {
+            let rx = 1 & (t / 2)
+            let ry = 1 & (t ^ rx)
+            if ry == 0 {
+                if rx == 1 {
+                    x = s &- 1 &- x
+                    y = s &- 1 &- y
+                }
+                swap(&x, &y)
+            }
+            x += s * rx
+            y += s * ry
+            t /= 4
+            s <<= 1
+        }
+        return (UInt32(truncatingIfNeeded: x), UInt32(truncatingIfNeeded: y))
+    }
+
+    static func hilbert(_ point: GLMapPoint, bits: Int = 32) -> UInt64 {
+        let (x, y) = quantize(point, bits: bits)
+        return hilbert(x: x, y: y, order: bits)
+    }
+
+    static func hilbertDecodePoint(_ key: UInt64, bits: Int = 32) -> GLMapPoint {
+        let (x, y) = hilbertDecode(key, order: bits)
+        return dequantize(x, y, bits: bits)
+    }
+
+    static func hilbert(_ tile: GLMapTilePos) -> UInt64 {
+        let (x, y) = tileCell(tile)
+        return UInt64(tile.z) << 58 | hilbert(x: x, y: y, order: Int(tile.z))
+    }
+
+    static func hilbertDecodeTile(_ key: UInt64) -> GLMapTilePos {
+        let z = Int(key >> 58)
+        let (x, y) = hilbertDecode(key & (1 << 58 - 1), order: z)
+        return GLMapTilePos(x: Int32(x), y: Int32(y), z: Int32(z))
+    }
+
+    // MARK: Batch
+
+    static func mortonKeys(_ points: [GLMapPoint], bits: Int = 32) -> [UInt64] {
+        let scale = quantizeScale(bits)
+        let limit = Double(maxCell(bits))
+        return points.map { p in
+            morton(x: UInt32(min(max(p.x * scale, 0), limit)), y: UInt32(min(max(p.y * scale, 0), limit)))
+        }
+    }
+
+    static func hilbertKeys(_ points: [GLMapPoint], bits: Int = 32) -> [UInt64] {
+        let scale = quantizeScale(bits)
+        let limit = Double(maxCell(bits))
+        return points.map { p in
+            hilbert(x: UInt32(min(max(p.x * scale, 0), limit)), y: UInt32(min(max(p.y * scale, 0), limit)), order: bits)
+        }
+    }
+
+    /// Points reordered along the Hilbert curve, the best general-purpose locality order.
+    static func sortedByHilbert(_ points: [GLMapPoint], bits: Int = 32) -> [GLMapPoint] {
+        let keys = hilbertKeys(points, bits: bits)
+        return keys.indices.sorted { keys[$0] < keys[$1] }.map { points[$0] }
+    }
+
+    // MARK: Bits
+
+    // Magic-number bit spreading. ARM has no PDEP/PEXT and Swift exposes no BMI2 intrinsics, so this
+    // portable form is what runs everywhere; it compiles to a handful of shifts and masks.
+    static func spread(_ v: UInt32) -> UInt64 {
+        var x = UInt64(v)
+        x = (x | x << 16) & 0x0000_FFFF_0000_FFFF
+        x = (x | x << 8) & 0x00FF_00FF_00FF_00FF
+        x = (x | x << 4) & 0x0F0F_0F0F_0F0F_0F0F
+        x = (x | x << 2) & 0x3333_3333_3333_3333
+        x = (x | x << 1) & 0x5555_5555_5555_5555
+        return x
+    }
+
+    static func compact(_ v: UInt64) -> UInt32 {
+        var x = v & 0x5555_5555_5555_5555
+        x = (x | x >> 1) & 0x3333_3333_3333_3333
+        x = (x | x >> 2) & 0x0F0F_0F0F_0F0F_0F0F
+        x = (x | x >> 4) & 0x00FF_00FF_00FF_00FF
+        x = (x | x >> 8) & 0x0000_FFFF_0000_FFFF
+        x = (x | x >> 16) & 0x0000_0000_FFFF_FFFF
+        return UInt32(x)
+    }
+
+    /// Tile x and y reduced modulo `2^z`.
+    private static func tileCell(_ tile: GLMapTilePos) -> (UInt32, UInt32) {
+        precondition(tile.z >= 0 && tile.z <= 29, "tile zoom out of range")
+        let mask = UInt32(1) << UInt32(tile.z) - 1
+        return (UInt32(truncatingIfNeeded: tile.x) & mask, UInt32(truncatingIfNeeded: tile.y) & mask)
+    }
+
+    private static func maxCell(_ bits: Int) -> UInt64 {
+        return bits >= 32 ? UInt64(UInt32.max) : (1 << UInt64(bits)) - 1
+    }
+
+    private static func quantizeScale(_ bits: Int) -> Double {
+        return Double(maxCell(bits) + 1) / Double(GLMapPointMax)
+    }
+
+    private static func quantize(_ point: GLMapPoint, bits: Int) -> (UInt32, UInt32) {
+        let scale = quantizeScale(bits)
+        let limit = Double(maxCell(bits))
+        return (UInt32(min(max(point.x * scale, 0), limit)), UInt32(min(max(point.y * scale, 0), limit)))
+    }
+
+    private static func dequantize(_ x: UInt32, _ y: UInt32, bits: Int) -> GLMapPoint {
+        let scale = quantizeScale(bits)
+        return GLMapPoint(x: (Double(x) + 0.5) / scale, y: (Double(y) + 0.5) / scale)
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  Atomic.h
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+#ifndef Atomic_h
+#define Atomic_h
+
+#include <stdint.h>
+
+// Sequentially consistent operations on plain machine words, for Swift code that has to stay off
+// locks. Swift has no atomics of its own before the Synchronization module of iOS 18. The storage
+// must be allocated manually (not a Swift stored property) so its address is stable.
+
+static inline void *_Nullable AtomicLoadPointer(void *_Nullable const *_Nonnull p) {
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+static inline void AtomicStorePointer(void *_Nullable *_Nonnull p, void *_Nullable value) {
+    __atomic_store_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+static inline void *_Nullable AtomicExchangePointer(void *_Nullable *_Nonnull p, void *_Nullable value) {
+    return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+static inline intptr_t AtomicLoadInt(const intptr_t *_Nonnull p) {
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+/// Returns the value before the addition.
+static inline intptr_t AtomicFetchAddInt(intptr_t *_Nonnull p, intptr_t delta) {
+    return __atomic_fetch_add(p, delta, __ATOMIC_SEQ_CST);
+}
+
+#endif /* Atomic_h */
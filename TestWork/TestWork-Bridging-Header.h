@@ -0,0 +1,8 @@
+//
+//  TestWork-Bridging-Header.h
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+#import "Helpers/Atomic.h"
@@ -0,0 +1,350 @@
+//
+//  MapMatcher.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Snaps a stream of noisy GPS fixes onto road geometry with a hidden Markov model.
+///
+/// Every fix gets up to `maxCandidates` road positions within `searchRadius`, found through a
+/// `MapBBoxIndex` over road segments. Viterbi scores combine the GPS error of each candidate with how
+/// well the road route between consecutive candidates agrees with the straight-line distance between
+/// fixes. Routes come from a bounded Dijkstra over the road graph, where roads connect at shared vertices.
+///
+/// Matching is incremental: as soon as all surviving paths share an ancestor, everything up to it is final
+/// and moves to `matchedTraces`, so the lattice stays a few fixes deep on a long trace. A fix that cannot be
+/// reached from the previous one starts a new trace, so disconnected stretches are never joined by a jump.
+final class MapMatcher {
+    struct Options {
+        /// Candidate search radius around a fix, meters.
+        var searchRadius = 50.0
+        /// GPS error, meters.
+        var sigma = 5.0
+        /// Tolerated difference between route and straight-line distance, meters.
+        var beta = 10.0
+        var maxCandidates = 8
+        /// Routes longer than `routeFactor` times the straight-line distance plus `routeSlack` meters are not followed.
+        var routeFactor = 4.0
+        var routeSlack = 200.0
+    }
+
+    private struct Edge {
+        let a: Int
+        let b: Int
+        /// Meters.
+        let length: Double
+    }
+
+    private struct Candidate {
+        let edge: Int
+        let fraction: Double
+        let point: GLMapPoint
+        var score: Double
+        var back: Int
+    }
+
+    let options: Options
+
+    private var nodes: [GLMapPoint] = []
+    private var adjacency: [[(node: Int, length: Double)]] = []
+    private var edges: [Edge] = []
+    /// Segment boxes; ids equal edge indices since nothing is ever removed.
+    private let edgeIndex = MapBBoxIndex()
+
+    private var lattice: [[Candidate]] = []
+    private var headCommitted = false
+    private var previousFix: GLMapGeoPoint?
+    private var lastCommitted: Candidate?
+
+    /// Final matched geometry, one polyline per connected trace: snapped fixes joined by the road vertices
+    /// between them.
+    private(set) var matchedTraces: [[GLMapPoint]] = []
+
+    init(roads: [[GLMapPoint]], options: Options = Options()) {
+        self.options = options
+        var nodeIDs: [NodeKey: Int] = [:]
+        for road in roads {
+            var previous = -1
+            for p in road {
+                let key = NodeKey(p)
+                let node: Int
+                if let existing = nodeIDs[key] {
+                    node = existing
+                } else {
+                    node = nodes.count
+                    nodeIDs[key] = node
+                    nodes.append(p)
+                    adjacency.append([])
+                }
+                if previous >= 0 && previous != node {
+                    let length = nodes[previous].distanceTo(p)
+                    edges.append(Edge(a: previous, b: node, length: length))
+                    adjacency[previous].append((node, length))
+                    adjacency[node].append((previous, length))
+                    let a = nodes[previous]
+                    edgeIndex.insert(GLMapBBox(origin: GLMapPoint(x: min(a.x, p.x), y: min(a.y, p.y)),
+                                               width: abs(p.x - a.x), height: abs(p.y - a.y)))
+                }
+                previous = node
+            }
+        }
+    }
+
+    /// Roads from vector lines, for example a navigation data set loaded as `GLMapVectorLine` objects.
+    convenience init(roads: [GLMapVectorLine], options: Options = Options()) {
+        var polylines: [[GLMapPoint]] = []
+        for line in roads {
+            for array in line.lines {
+                var points: [GLMapPoint] = []
+                points.reserveCapacity(Int(array.count))
+                array.enumeratePoints { _, p in points.append(p) }
+                polylines.append(points)
+            }
+        }
+        self.init(roads: polylines, options: options)
+    }
+
+    // MARK: Matching
+
+    /// Adds a fix and returns the position it currently matches to, `nil` if no road is within reach.
+    /// The returned position can still change until the fix is committed.
+    @discardableResult
+    func add(_ fix: GLMapGeoPoint) -> GLMapPoint? {
+        let point = GLMapPoint(geoPoint: fix)
+        var layer = candidates(point)
+        guard !layer.isEmpty else { return nil }
+
+        if let previous = lattice.last, let previousFix = previousFix {
+            let straight = previousFix.distanceTo(fix)
+            let limit = straight * options.routeFactor + options.routeSlack
+            for j in layer.indices {
+                layer[j].score = -.infinity
+            }
+            for (i, from) in previous.enumerated() where from.score > -.infinity {
+                let search = dijkstra(from, limit)
+                for j in layer.indices {
+                    let route = routeLength(from, layer[j], search)
+                    guard route <= limit else { continue }
+                    let score = from.score - abs(route - straight) / options.beta
+                    if score > layer[j].score {
+                        layer[j].score = score
+                        layer[j].back = i
+                    }
+                }
+            }
+            if layer.allSatisfy({ $0.score == -.infinity }) {
+                // No candidate is reachable from the previous fix: close the current trace and start over.
+                finish()
+                layer = candidates(point)
+            } else {
+                for j in layer.indices where layer[j].score > -.infinity {
+                    layer[j].score += emission(point, layer[j])
+                }
+            }
+        }
+        if lattice.isEmpty {
+            for j in layer.indices {
+                layer[j].score = emission(point, layer[j])
+                layer[j].back = -1
+            }
+        }
+        lattice.append(layer)
+        previousFix = fix
+        commitConverged()
+        return layer.max { $0.score < $1.score }?.point
+    }
+
+    /// Commits the best path through the remaining fixes.
+    func finish() {
+        guard let last = lattice.last, let best = last.indices.max(by: { last[$0].score < last[$1].score }) else { return }
+        commit(through: lattice.count - 1, best)
+        lattice.removeAll()
+        headCommitted = false
+        previousFix = nil
+        lastCommitted = nil
+    }
+
+    /// Committed traces with the current best guess for the uncommitted fixes added to the last one.
+    func currentTraces() -> [[GLMapPoint]] {
+        var traces = matchedTraces
+        guard let last = lattice.last, var j = last.indices.max(by: { last[$0].score < last[$1].score }) else { return traces }
+        var tail: [GLMapPoint] = []
+        for k in stride(from: lattice.count - 1, through: headCommitted ? 1 : 0, by: -1) {
+            tail.append(lattice[k][j].point)
+            j = max(lattice[k][j].back, 0)
+        }
+        if lastCommitted == nil {
+            traces.append([])
+        }
+        traces[traces.count - 1] += tail.reversed()
+        return traces
+    }
+
+    /// One track per trace.
+    func trackData(color: GLMapColor) -> [GLMapTrackData] {
+        return currentTraces().compactMap { points in
+            guard !points.isEmpty else { return nil }
+            return GLMapTrackData(pointsCallback: { i, pt in
+                pt.pointee = GLTrackPoint(pt: points[Int(i)], color: color)
+                return true
+            }, count: UInt(points.count))
+        }
+    }
+
+    func reset() {
+        lattice.removeAll()
+        headCommitted = false
+        previousFix = nil
+        lastCommitted = nil
+        matchedTraces.removeAll()
+    }
+
+    // MARK: Lattice
+
+    private func candidates(_ point: GLMapPoint) -> [Candidate] {
+        let r = options.searchRadius * MapPointIndex.mapUnitsPerMeter(at: point)
+        let box = GLMapBBox(origin: GLMapPoint(x: point.x - r, y: point.y - r), width: 2 * r, height: 2 * r)
+        var found: [(Double, Candidate)] = []
+        edgeIndex.query(box) { e in
+            let a = nodes[edges[e].a], b = nodes[edges[e].b]
+            let abx = b.x - a.x, aby = b.y - a.y
+            let len2 = abx * abx + aby * aby
+            let t = len2 > 0 ? min(max(((point.x - a.x) * abx + (point.y - a.y) * aby) / len2, 0), 1) : 0
+            let p = GLMapPoint(x: a.x + t * abx, y: a.y + t * aby)
+            let d = distanceSquared(p, point)
+            if d <= r * r {
+                found.append((d, Candidate(edge: e, fraction: t, point: p, score: 0, back: -1)))
+            }
+        }
+        found.sort { $0.0 < $1.0 }
+        return found.prefix(options.maxCandidates).map { $0.1 }
+    }
+
+    private func emission(_ fix: GLMapPoint, _ c: Candidate) -> Double {
+        let d = fix.distanceTo(c.point) / options.sigma
+        return -0.5 * d * d
+    }
+
+    /// Finds the latest layer all surviving paths pass through and commits everything up to it.
+    private func commitConverged() {
+        guard lattice.count > 1, let last = lattice.last else { return }
+        var alive = Set(last.indices.filter { last[$0].score > -.infinity })
+        var k = lattice.count - 1
+        while k > 0 && alive.count > 1 {
+            alive = Set(alive.map { lattice[k][$0].back })
+            k -= 1
+        }
+        guard alive.count == 1, let s = alive.first, k > 0 || !headCommitted else { return }
+        commit(through: k, s)
+
+        // Keep the committed candidate as the root of the remaining lattice.
+        var root = lattice[k][s]
+        root.back = -1
+        var rest = Array(lattice[(k + 1)...])
+        if !rest.isEmpty {
+            // Candidates that do not descend from the root can no longer be on the best path.
+            for j in rest[0].indices where rest[0][j].back != s {
+                rest[0][j].score = -.infinity
+            }
+            for j in rest[0].indices {
+                rest[0][j].back = 0
+            }
+        }
+        lattice = [[root]] + rest
+        headCommitted = true
+    }
+
+    /// Appends the path ending at `lattice[k][j]` to the last trace, with road vertices between fixes. The
+    /// first commit after a break opens a new trace.
+    private func commit(through k: Int, _ j: Int) {
+        var path: [Candidate] = []
+        var j = j
+        for layer in stride(from: k, through: headCommitted ? 1 : 0, by: -1) {
+            path.append(lattice[layer][j])
+            j = max(lattice[layer][j].back, 0)
+        }
+        if lastCommitted == nil {
+            matchedTraces.append([])
+        }
+        let t = matchedTraces.count - 1
+        for c in path.reversed() {
+            if let from = lastCommitted {
+                matchedTraces[t] += route(from, c)
+            }
+            matchedTraces[t].append(c.point)
+            lastCommitted = c
+        }
+    }
+
+    // MARK: Routing
+
+    private struct Search {
+        var distance: [Int: Double] = [:]
+        var previous: [Int: Int] = [:]
+    }
+
+    /// Bounded Dijkstra from a position on an edge, both directions along the edge.
+    private func dijkstra(_ from: Candidate, _ limit: Double) -> Search {
+        var search = Search()
+        var heap = DistanceHeap()
+        let e = edges[from.edge]
+        for (node, d) in [(e.a, from.fraction * e.length), (e.b, (1 - from.fraction) * e.length)] where d < search.distance[node, default: .infinity] {
+            search.distance[node] = d
+            search.previous[node] = -1
+            heap.push(d, node)
+        }
+        while let (d, node) = heap.pop() {
+            guard d <= limit else { break }
+            guard d == search.distance[node] else { continue }
+            for (next, length) in adjacency[node] where d + length < search.distance[next, default: .infinity] {
+                search.distance[next] = d + length
+                search.previous[next] = node
+                heap.push(d + length, next)
+            }
+        }
+        return search
+    }
+
+    private func routeLength(_ from: Candidate, _ to: Candidate, _ search: Search) -> Double {
+        let e = edges[to.edge]
+        if from.edge == to.edge {
+            return abs(to.fraction - from.fraction) * e.length
+        }
+        let viaA = search.distance[e.a, default: .infinity] + to.fraction * e.length
+        let viaB = search.distance[e.b, default: .infinity] + (1 - to.fraction) * e.length
+        return min(viaA, viaB)
+    }
+
+    /// Road vertices between two committed candidates, empty when they share an edge or are not connected.
+    private func route(_ from: Candidate, _ to: Candidate) -> [GLMapPoint] {
+        guard from.edge != to.edge else { return [] }
+        let straight = from.point.distanceTo(to.point)
+        let search = dijkstra(from, straight * options.routeFactor + options.routeSlack)
+        let e = edges[to.edge]
+        let viaA = search.distance[e.a, default: .infinity] + to.fraction * e.length
+        let viaB = search.distance[e.b, default: .infinity] + (1 - to.fraction) * e.length
+        var node = viaA <= viaB ? e.a : e.b
+        guard min(viaA, viaB) < .infinity else { return [] }
+        var nodesOnPath: [GLMapPoint] = []
+        while node >= 0 {
+            nodesOnPath.append(nodes[node])
+            node = search.previous[node] ?? -1
+        }
+        return nodesOnPath.reversed()
+    }
+}
+
+/// Road vertex identity, by bit pattern, so roads that share a vertex are connected.
+private struct NodeKey: Hashable {
+    let x: UInt64
+    let y: UInt64
+
+    init(_ p: GLMapPoint) {
+        x = p.x.bitPattern
+        y = p.y.bitPattern
+    }
+}
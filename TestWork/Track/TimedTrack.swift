@@ -0,0 +1,166 @@
+//
+//  TimedTrack.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Track points with a timestamp channel, for history playback and "where was this user at 14:30".
+///
+/// Times are seconds since 1970 and never decrease, so any time maps to a point by binary search. The
+/// distance from the start is kept per point as well, which gives the progress at a time directly.
+final class TimedTrack {
+    private(set) var points: [GLTrackPoint] = []
+    private(set) var times: [TimeInterval] = []
+    /// Meters from the first point to each point.
+    private(set) var distances: [Double] = []
+    private var cachedStats: TrackStats?
+
+    var count: Int { points.count }
+    var startTime: TimeInterval? { times.first }
+    var endTime: TimeInterval? { times.last }
+
+    init() { }
+
+    init(points: [GLTrackPoint], times: [TimeInterval]) {
+        precondition(points.count == times.count)
+        reserveCapacity(points.count)
+        for i in 0..<points.count {
+            append(points[i], time: times[i])
+        }
+    }
+
+    /// Whole file written with timestamps, `nil` if the file has none.
+    convenience init?(reader: TrackFileReader) {
+        guard reader.hasTimestamps else { return nil }
+        var points: [GLTrackPoint] = []
+        var dates: [Date] = []
+        points.reserveCapacity(reader.count)
+        dates.reserveCapacity(reader.count)
+        for b in 0..<reader.index.count {
+            guard reader.decodeBlock(b, into: &points, times: &dates) else { return nil }
+        }
+        self.init(points: points, times: dates.map { $0.timeIntervalSince1970 })
+    }
+
+    func reserveCapacity(_ n: Int) {
+        points.reserveCapacity(n)
+        times.reserveCapacity(n)
+        distances.reserveCapacity(n)
+    }
+
+    /// Appends a point. Times earlier than the last one are clamped to it, so the channel stays sorted.
+    func append(_ point: GLTrackPoint, time: TimeInterval) {
+        let last = points.last
+        distances.append(last.map { distances[distances.count - 1] + $0.pt.distanceTo(point.pt) } ?? 0)
+        times.append(max(time, times.last ?? time))
+        points.append(point)
+        cachedStats = nil
+    }
+
+    // MARK: Queries
+
+    /// Index of the last point at or before `time`, `nil` if the track starts later.
+    func index(at time: TimeInterval) -> Int? {
+        let i = upperBound(time, 0, times.count)
+        return i > 0 ? i - 1 : nil
+    }
+
+    /// Position at `time`, interpolated linearly between the surrounding points and clamped to the track.
+    func position(at time: TimeInterval) -> GLMapPoint? {
+        guard let (i, t) = locate(time) else { return nil }
+        guard t > 0 else { return points[i].pt }
+        let a = points[i].pt, b = points[i + 1].pt
+        return GLMapPoint(x: a.x + (b.x - a.x) * t, y: a.y + (b.y - a.y) * t)
+    }
+
+    /// Meters travelled by `time`, interpolated between points.
+    func progress(at time: TimeInterval) -> Double? {
+        guard let (i, t) = locate(time) else { return nil }
+        guard t > 0 else { return distances[i] }
+        return distances[i] + (distances[i + 1] - distances[i]) * t
+    }
+
+    /// Points recorded in `[from, to]`, as a view that shares storage with the track.
+    func slice(from: TimeInterval, to: TimeInterval) -> TimedTrackSlice {
+        let lo = lowerBound(from, 0, times.count)
+        let hi = max(lo, upperBound(to, lo, times.count))
+        return TimedTrackSlice(track: self, range: lo..<hi)
+    }
+
+    func slice(_ interval: DateInterval) -> TimedTrackSlice {
+        return slice(from: interval.start.timeIntervalSince1970, to: interval.end.timeIntervalSince1970)
+    }
+
+    /// Stats for the whole track, kept until the next append. Results without elevation data are not
+    /// kept, so they are picked up once the area is downloaded.
+    func stats(profileSpacing: Double = 100) -> TrackStats {
+        if let stats = cachedStats, stats.profileSpacing == profileSpacing {
+            return stats
+        }
+        let stats = TrackStats(track: self, profileSpacing: profileSpacing)
+        cachedStats = stats.ascent == nil ? nil : stats
+        return stats
+    }
+
+    // MARK: Search
+
+    /// Segment start and fraction along it for `time`, clamped to the ends of the track.
+    private func locate(_ time: TimeInterval) -> (Int, Double)? {
+        guard let first = times.first, let last = times.last else { return nil }
+        if time <= first { return (0, 0) }
+        if time >= last { return (times.count - 1, 0) }
+        let i = upperBound(time, 0, times.count) - 1
+        let span = times[i + 1] - times[i]
+        return (i, span > 0 ? (time - times[i]) / span : 0)
+    }
+
+    private func lowerBound(_ time: TimeInterval, _ lo: Int, _ hi: Int) -> Int {
+        var lo = lo, hi = hi
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if times[mid] < time { lo = mid + 1 } else { hi = mid }
+        }
+        return lo
+    }
+
+    private func upperBound(_ time: TimeInterval, _ lo: Int, _ hi: Int) -> Int {
+        var lo = lo, hi = hi
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if times[mid] <= time { lo = mid + 1 } else { hi = mid }
+        }
+        return lo
+    }
+}
+
+/// Time window of a `TimedTrack`. Holds the track and an index range, nothing is copied until
+/// `makeTrackData()` hands the points to the framework.
+struct TimedTrackSlice {
+    let track: TimedTrack
+    let range: Range<Int>
+
+    var isEmpty: Bool { range.isEmpty }
+    var points: ArraySlice<GLTrackPoint> { track.points[range] }
+    var times: ArraySlice<TimeInterval> { track.times[range] }
+
+    /// Meters covered inside the window.
+    var length: Double {
+        guard let first = range.first, let last = range.last else { return 0 }
+        return track.distances[last] - track.distances[first]
+    }
+
+    func stats(profileSpacing: Double = 100) -> TrackStats {
+        return TrackStats(track: track, range: range, profileSpacing: profileSpacing)
+    }
+
+    func makeTrackData() -> GLMapTrackData? {
+        guard !range.isEmpty else { return nil }
+        return track.points.withUnsafeBufferPointer { buffer in
+            GLMapTrackData(points: buffer.baseAddress! + range.lowerBound, count: UInt(range.count))
+        }
+    }
+}
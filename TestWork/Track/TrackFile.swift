@@ -0,0 +1,389 @@
+//
+//  TrackFile.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Compact on-disk track format.
+///
+/// Points are stored on the `MapPointI` grid in blocks of up to `blockSize`. Inside a block the first
+/// point is absolute and the rest are zigzag varint deltas; colors are run-length encoded and optional
+/// timestamps (milliseconds) are delta varints as well. A block index at the end of the file records each
+/// block's offset, first point, length from the track start and first timestamp, so a reader can seek by
+/// point, progress or time and decode only the blocks it needs.
+///
+/// Color runs restart at every block rather than following track segments, so any block decodes on its
+/// own. A track is stored as a single segment: `GLMapTrackData` can only be built as one segment from a
+/// point source, so split segments are written as separate files.
+///
+///     "GLTK" version flags
+///     block*: count, x0, y0, dx dy..., [run length, color]..., [t0, dt...]
+///     index: (offset, firstPoint, startLength, startTime) * blockCount
+///     footer: indexOffset, blockCount, pointCount, "GLTK"
+enum TrackFile {
+    static let blockSize = 1024
+
+    fileprivate static let magic: [UInt8] = Array("GLTK".utf8)
+    fileprivate static let version: UInt8 = 1
+    fileprivate static let hasTimestamps: UInt8 = 1
+    fileprivate static let headerSize = 4 + 1 + 1
+    fileprivate static let footerSize = 8 + 4 + 8 + 4
+    fileprivate static let indexEntrySize = 8 + 8 + 8 + 8
+
+    struct BlockInfo {
+        let offset: Int
+        let firstPoint: Int
+        /// Track length before the block's first point, in meters.
+        let startLength: Double
+        /// Milliseconds since 1970 of the block's first point, 0 without timestamps.
+        let startTime: Int64
+    }
+
+    /// Writes `points` in one go.
+    @discardableResult
+    static func write(_ points: [GLTrackPoint], timestamps: [Date]? = nil, to url: URL) -> Bool {
+        precondition(timestamps == nil || timestamps?.count == points.count)
+        guard let writer = TrackFileWriter(url: url, timestamps: timestamps != nil) else { return false }
+        for i in 0..<points.count {
+            writer.append(points[i], time: timestamps?[i])
+        }
+        return writer.finish()
+    }
+}
+
+// MARK: - Writing
+
+/// Streaming writer: points are buffered one block at a time and flushed as blocks fill up, so
+/// recording a long track never holds more than a block in memory.
+final class TrackFileWriter {
+    private let handle: FileHandle
+    private let timestamps: Bool
+    private var offset = 0
+    private var index: [TrackFile.BlockInfo] = []
+    private var count = 0
+    private var length = 0.0
+    private var last: GLMapPoint?
+
+    private var points: [MapPointI] = []
+    private var colors: [GLMapColor] = []
+    private var times: [Int64] = []
+    private var blockStartLength = 0.0
+    private var finished = false
+
+    init?(url: URL, timestamps: Bool) {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil),
+              let handle = FileHandle(forWritingAtPath: url.path) else { return nil }
+        self.handle = handle
+        self.timestamps = timestamps
+        emit(TrackFile.magic + [TrackFile.version, timestamps ? TrackFile.hasTimestamps : 0])
+    }
+
+    deinit {
+        finish()
+    }
+
+    /// `time` is required when the file has timestamps and must be `nil` otherwise.
+    func append(_ point: GLTrackPoint, time: Date? = nil) {
+        precondition(!finished)
+        precondition((time != nil) == timestamps, timestamps ? "missing timestamp" : "file has no timestamps")
+        if points.isEmpty {
+            blockStartLength = length
+        }
+        if let last = last {
+            length += last.distanceTo(point.pt)
+        }
+        last = point.pt
+        points.append(MapPointI(point.pt))
+        colors.append(point.color)
+        if let time = time {
+            times.append(Int64((time.timeIntervalSince1970 * 1000).rounded()))
+        }
+        count += 1
+        if points.count == TrackFile.blockSize {
+            flushBlock()
+        }
+    }
+
+    /// Writes the index and footer. Called from `deinit` if not called explicitly.
+    @discardableResult
+    func finish() -> Bool {
+        guard !finished else { return true }
+        finished = true
+        flushBlock()
+
+        var bytes: [UInt8] = []
+        let indexOffset = offset
+        for block in index {
+            bytes.appendFixed(UInt64(block.offset))
+            bytes.appendFixed(UInt64(block.firstPoint))
+            bytes.appendFixed(block.startLength.bitPattern)
+            bytes.appendFixed(UInt64(bitPattern: block.startTime))
+        }
+        bytes.appendFixed(UInt64(indexOffset))
+        bytes.appendFixed(UInt32(index.count))
+        bytes.appendFixed(UInt64(count))
+        bytes += TrackFile.magic
+        emit(bytes)
+        handle.closeFile()
+        return true
+    }
+
+    private func flushBlock() {
+        guard let first = points.first else { return }
+        index.append(TrackFile.BlockInfo(offset: offset, firstPoint: count - points.count,
+                                         startLength: blockStartLength, startTime: times.first ?? 0))
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(points.count * 4)
+        bytes.appendVarint(UInt64(points.count))
+        bytes.appendVarint(UInt64(UInt32(bitPattern: first.x)))
+        bytes.appendVarint(UInt64(UInt32(bitPattern: first.y)))
+        for i in 1..<points.count {
+            bytes.appendVarint(zigzag(Int64(points[i].x) - Int64(points[i - 1].x)))
+            bytes.appendVarint(zigzag(Int64(points[i].y) - Int64(points[i - 1].y)))
+        }
+
+        var runStart = 0
+        for i in 1...colors.count where i == colors.count || colors[i].color != colors[runStart].color {
+            bytes.appendVarint(UInt64(i - runStart))
+            bytes.appendFixed(colors[runStart].color)
+            runStart = i
+        }
+
+        if timestamps, let t0 = times.first {
+            bytes.appendVarint(zigzag(t0))
+            for i in 1..<times.count {
+                bytes.appendVarint(zigzag(times[i] - times[i - 1]))
+            }
+        }
+        emit(bytes)
+        points.removeAll(keepingCapacity: true)
+        colors.removeAll(keepingCapacity: true)
+        times.removeAll(keepingCapacity: true)
+    }
+
+    private func emit(_ bytes: [UInt8]) {
+        handle.write(Data(bytes))
+        offset += bytes.count
+    }
+}
+
+// MARK: - Reading
+
+/// Memory-mapped reader. Opening reads only the footer and the block index; blocks are decoded on demand.
+/// The footer and index are checked against the file size when opening, and every read inside a block is
+/// bounded by the block's end, so a truncated or corrupt file fails instead of reading past the mapping.
+final class TrackFileReader {
+    private let data: Data
+    private let timestamps: Bool
+    private let indexOffset: Int
+
+    let index: [TrackFile.BlockInfo]
+    let count: Int
+
+    var hasTimestamps: Bool { timestamps }
+
+    init?(url: URL) {
+        guard let data = try? Data(contentsOf: url, options: .alwaysMapped),
+              data.count >= TrackFile.headerSize + TrackFile.footerSize,
+              Array(data.prefix(4)) == TrackFile.magic, Array(data.suffix(4)) == TrackFile.magic,
+              data[data.startIndex + 4] == TrackFile.version else { return nil }
+        self.data = data
+        timestamps = data[data.startIndex + 5] & TrackFile.hasTimestamps != 0
+
+        let footer = data.count - TrackFile.footerSize
+        let indexOffset = Int(truncatingIfNeeded: data.readFixed(UInt64.self, at: footer))
+        let blockCount = Int(data.readFixed(UInt32.self, at: footer + 8))
+        let count = Int(truncatingIfNeeded: data.readFixed(UInt64.self, at: footer + 12))
+        guard indexOffset >= TrackFile.headerSize, indexOffset <= footer, count >= 0, (count == 0) == (blockCount == 0),
+              indexOffset + blockCount * TrackFile.indexEntrySize == footer else { return nil }
+        let index = (0..<blockCount).map { i -> TrackFile.BlockInfo in
+            let at = indexOffset + i * TrackFile.indexEntrySize
+            return TrackFile.BlockInfo(offset: Int(truncatingIfNeeded: data.readFixed(UInt64.self, at: at)),
+                                       firstPoint: Int(truncatingIfNeeded: data.readFixed(UInt64.self, at: at + 8)),
+                                       startLength: Double(bitPattern: data.readFixed(UInt64.self, at: at + 16)),
+                                       startTime: Int64(bitPattern: data.readFixed(UInt64.self, at: at + 24)))
+        }
+        // Blocks follow the header back to back up to the index, and each holds at least one point.
+        for (i, block) in index.enumerated() {
+            let previous = i > 0 ? index[i - 1] : nil
+            guard block.offset < indexOffset, block.firstPoint < count,
+                  block.offset > previous?.offset ?? TrackFile.headerSize - 1,
+                  block.firstPoint > previous?.firstPoint ?? -1,
+                  previous != nil || (block.offset == TrackFile.headerSize && block.firstPoint == 0) else { return nil }
+        }
+        self.indexOffset = indexOffset
+        self.index = index
+        self.count = count
+    }
+
+    // MARK: Seeking
+
+    func block(containingPoint i: Int) -> Int {
+        return lastBlock { $0.firstPoint <= i }
+    }
+
+    /// Block containing the point `length` meters from the start.
+    func block(containingLength length: Double) -> Int {
+        return lastBlock { $0.startLength <= length }
+    }
+
+    func block(containingTime time: Date) -> Int {
+        let ms = Int64((time.timeIntervalSince1970 * 1000).rounded())
+        return lastBlock { $0.startTime <= ms }
+    }
+
+    // MARK: Decoding
+
+    /// Decodes one block. `times` is filled only when the file has timestamps. Returns false and appends
+    /// nothing if the block is corrupt.
+    @discardableResult
+    func decodeBlock(_ b: Int, into points: inout [GLTrackPoint], times: inout [Date]) -> Bool {
+        let start = points.count, timesStart = times.count
+        let end = b + 1 < index.count ? index[b + 1].offset : indexOffset
+        let n = (b + 1 < index.count ? index[b + 1].firstPoint : count) - index[b].firstPoint
+        let ok = data.withUnsafeBytes { raw -> Bool in
+            var cursor = index[b].offset
+            guard raw.readVarint(&cursor, end) == UInt64(n),
+                  let x0 = raw.readVarint(&cursor, end), let y0 = raw.readVarint(&cursor, end) else { return false }
+            var x = Int64(UInt32(truncatingIfNeeded: x0))
+            var y = Int64(UInt32(truncatingIfNeeded: y0))
+            points.append(GLTrackPoint(pt: GLMapPoint(x: Double(x), y: Double(y)), color: GLMapColor.black))
+            for _ in 1..<n {
+                guard let dx = raw.readVarint(&cursor, end), let dy = raw.readVarint(&cursor, end) else { return false }
+                x &+= unzigzag(dx)
+                y &+= unzigzag(dy)
+                points.append(GLTrackPoint(pt: GLMapPoint(x: Double(x), y: Double(y)), color: GLMapColor.black))
+            }
+
+            var filled = 0
+            while filled < n {
+                guard let run = raw.readVarint(&cursor, end), run > 0, run <= UInt64(n - filled), cursor + 4 <= end else { return false }
+                let color = GLMapColor(color: UInt32(littleEndian: raw.loadUnaligned(fromByteOffset: cursor, as: UInt32.self)))
+                cursor += 4
+                for i in 0..<Int(run) {
+                    points[start + filled + i].color = color
+                }
+                filled += Int(run)
+            }
+
+            if timestamps {
+                guard var t = raw.readVarint(&cursor, end).map(unzigzag) else { return false }
+                times.append(Date(timeIntervalSince1970: Double(t) / 1000))
+                for _ in 1..<n {
+                    guard let dt = raw.readVarint(&cursor, end) else { return false }
+                    t &+= unzigzag(dt)
+                    times.append(Date(timeIntervalSince1970: Double(t) / 1000))
+                }
+            }
+            return true
+        }
+        if !ok {
+            points.removeSubrange(start...)
+            times.removeSubrange(timesStart...)
+        }
+        return ok
+    }
+
+    /// Points `range`, decoding only the blocks that overlap it.
+    func points(_ range: Range<Int>) -> [GLTrackPoint] {
+        guard !range.isEmpty else { return [] }
+        var result: [GLTrackPoint] = []
+        var times: [Date] = []
+        let first = block(containingPoint: range.lowerBound)
+        result.reserveCapacity(range.count + TrackFile.blockSize)
+        var b = first
+        while b < index.count && index[b].firstPoint < range.upperBound && decodeBlock(b, into: &result, times: &times) {
+            b += 1
+        }
+        let skip = range.lowerBound - index[first].firstPoint
+        guard skip < result.count else { return [] }
+        return Array(result[skip..<min(skip + range.count, result.count)])
+    }
+
+    func allPoints() -> [GLTrackPoint] {
+        return points(0..<count)
+    }
+
+    /// Track data for the whole file, decoded block by block straight into the framework's callback.
+    func makeTrackData() -> GLMapTrackData? {
+        guard count > 0 else { return nil }
+        var buffer: [GLTrackPoint] = []
+        var times: [Date] = []
+        var bufferStart = 0
+        var next = 0
+        return GLMapTrackData(pointsCallback: { i, pt in
+            let i = Int(i)
+            if i < bufferStart || i >= bufferStart + buffer.count {
+                // Points are asked for in order, so this is normally just the next block.
+                let b = next < self.index.count && self.index[next].firstPoint == i ? next : self.block(containingPoint: i)
+                buffer.removeAll(keepingCapacity: true)
+                times.removeAll(keepingCapacity: true)
+                guard self.decodeBlock(b, into: &buffer, times: &times) else { return false }
+                bufferStart = self.index[b].firstPoint
+                next = b + 1
+            }
+            pt.pointee = buffer[i - bufferStart]
+            return true
+        }, count: UInt(count))
+    }
+
+    private func lastBlock(_ predicate: (TrackFile.BlockInfo) -> Bool) -> Int {
+        var lo = 0, hi = index.count
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if predicate(index[mid]) { lo = mid + 1 } else { hi = mid }
+        }
+        return max(lo - 1, 0)
+    }
+}
+
+// MARK: - Encoding
+
+private func zigzag(_ v: Int64) -> UInt64 {
+    return UInt64(bitPattern: (v << 1) ^ (v >> 63))
+}
+
+private func unzigzag(_ v: UInt64) -> Int64 {
+    return Int64(bitPattern: v >> 1) ^ -Int64(bitPattern: v & 1)
+}
+
+private extension Array where Element == UInt8 {
+    mutating func appendVarint(_ v: UInt64) {
+        var v = v
+        while v >= 0x80 {
+            append(UInt8(v & 0x7F) | 0x80)
+            v >>= 7
+        }
+        append(UInt8(v))
+    }
+
+    mutating func appendFixed<T: FixedWidthInteger>(_ v: T) {
+        Swift.withUnsafeBytes(of: v.littleEndian) { append(contentsOf: $0) }
+    }
+}
+
+private extension UnsafeRawBufferPointer {
+    /// Varint at `cursor`, `nil` if it runs past `end` or is longer than 64 bits.
+    func readVarint(_ cursor: inout Int, _ end: Int) -> UInt64? {
+        var result: UInt64 = 0
+        var shift: UInt64 = 0
+        while true {
+            guard cursor < end, shift < 64 else { return nil }
+            let byte = self[cursor]
+            cursor += 1
+            result |= UInt64(byte & 0x7F) << shift
+            if byte < 0x80 { return result }
+            shift += 7
+        }
+    }
+}
+
+private extension Data {
+    func readFixed<T: FixedWidthInteger>(_ type: T.Type, at offset: Int) -> T {
+        return withUnsafeBytes { T(littleEndian: $0.loadUnaligned(fromByteOffset: offset, as: T.self)) }
+    }
+}
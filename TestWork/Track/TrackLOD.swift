@@ -0,0 +1,175 @@
+//
+//  TrackLOD.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Level-of-detail pyramid for a finished track, built once so that zoom changes never re-simplify.
+///
+/// One Douglas–Peucker pass records for every point the tolerance at which it would still be split off,
+/// capped by its parent's so coarser levels are always subsets of finer ones. That tolerance is turned into
+/// the coarsest zoom where the point survives, and the points for any zoom are a linear filter.
+final class TrackLOD {
+    static let maxZoom = 24
+
+    /// Zoom value of points that never survive, such as exact duplicates or collinear points.
+    static let never = UInt8(maxZoom + 1)
+
+    let points: [GLTrackPoint]
+    /// Coarsest zoom at which each point is kept.
+    let minZoom: [UInt8]
+
+    private let zoomCounts: [Int]
+    private var cache: [Int: GLMapTrackData] = [:]
+
+    /// - Parameters:
+    ///   - pixels: Simplification tolerance in screen points at each zoom.
+    ///   - parallel: Splits the pass across cores once the track divides into enough independent ranges.
+    init(points: [GLTrackPoint], pixels: Double = 1, parallel: Bool = true) {
+        self.points = points
+        let significance = TrackLOD.significance(points, parallel: parallel)
+
+        var minZoom = [UInt8](repeating: TrackLOD.never, count: points.count)
+        var zoomCounts = [Int](repeating: 0, count: TrackLOD.maxZoom + 2)
+        let scale = Double(GLMapPointMax) * pixels / 256
+        for i in 0..<points.count {
+            let s = significance[i]
+            let zoom: Int
+            if s == .infinity {
+                zoom = 0
+            } else if s > 0 {
+                // Smallest z with scale / 2^z < s.
+                zoom = min(max(Int((log2(scale / s)).rounded(.down)) + 1, 0), Int(TrackLOD.never))
+            } else {
+                zoom = Int(TrackLOD.never)
+            }
+            minZoom[i] = UInt8(zoom)
+            zoomCounts[zoom] += 1
+        }
+        self.minZoom = minZoom
+        self.zoomCounts = zoomCounts
+    }
+
+    // MARK: Extraction
+
+    /// Number of points kept at `zoom`.
+    func count(zoom: Int) -> Int {
+        return zoomCounts[0...min(max(zoom, 0), TrackLOD.maxZoom)].reduce(0, +)
+    }
+
+    func indices(zoom: Int) -> [Int] {
+        let z = UInt8(min(max(zoom, 0), TrackLOD.maxZoom))
+        var result: [Int] = []
+        result.reserveCapacity(count(zoom: zoom))
+        for i in 0..<minZoom.count where minZoom[i] <= z {
+            result.append(i)
+        }
+        return result
+    }
+
+    func points(zoom: Int) -> [GLTrackPoint] {
+        let z = UInt8(min(max(zoom, 0), TrackLOD.maxZoom))
+        var result: [GLTrackPoint] = []
+        result.reserveCapacity(count(zoom: zoom))
+        for i in 0..<minZoom.count where minZoom[i] <= z {
+            result.append(points[i])
+        }
+        return result
+    }
+
+    /// Track data for the map's fractional `mapZoomLevel`, rounded up so detail never drops below a pixel.
+    func trackData(zoomLevel: Double) -> GLMapTrackData? {
+        let zoom = min(max(Int(zoomLevel.rounded(.up)), 0), TrackLOD.maxZoom)
+        if let cached = cache[zoom] {
+            return cached
+        }
+        let selected = points(zoom: zoom)
+        guard !selected.isEmpty else { return nil }
+        let data = selected.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }
+        cache[zoom] = data
+        return data
+    }
+
+    // MARK: Douglas–Peucker
+
+    private struct Span {
+        let lo: Int
+        let hi: Int
+        let cap: Double
+    }
+
+    private static func significance(_ points: [GLTrackPoint], parallel: Bool) -> [Double] {
+        let n = points.count
+        var sig = [Double](repeating: 0, count: n)
+        guard n > 0 else { return sig }
+        sig[0] = .infinity
+        sig[n - 1] = .infinity
+        guard n > 2 else { return sig }
+
+        points.withUnsafeBufferPointer { pts in
+            sig.withUnsafeMutableBufferPointer { sig in
+                var ranges = [Span(lo: 0, hi: n - 1, cap: .infinity)]
+                guard parallel else {
+                    split(pts, sig, &ranges)
+                    return
+                }
+                // Split breadth-first until there is enough independent work, then finish the ranges
+                // concurrently; they write disjoint parts of `sig`.
+                let target = ProcessInfo.processInfo.activeProcessorCount * 8
+                while !ranges.isEmpty && ranges.count < target {
+                    ranges = ranges.flatMap { r -> [Span] in
+                        guard let (a, b) = step(pts, sig, r) else { return [] }
+                        return [a, b]
+                    }
+                }
+                let frontier = ranges
+                DispatchQueue.concurrentPerform(iterations: frontier.count) { i in
+                    var stack = [frontier[i]]
+                    split(pts, sig, &stack)
+                }
+            }
+        }
+        return sig
+    }
+
+    /// Processes ranges depth-first until none is left.
+    private static func split(_ pts: UnsafeBufferPointer<GLTrackPoint>, _ sig: UnsafeMutableBufferPointer<Double>, _ stack: inout [Span]) {
+        while !stack.isEmpty {
+            let r = stack.removeLast()
+            if let (a, b) = step(pts, sig, r) {
+                stack.append(a)
+                stack.append(b)
+            }
+        }
+    }
+
+    /// Finds the farthest point of `r`, records its capped significance and returns the two halves.
+    private static func step(_ pts: UnsafeBufferPointer<GLTrackPoint>, _ sig: UnsafeMutableBufferPointer<Double>, _ r: Span) -> (Span, Span)? {
+        guard r.hi - r.lo > 1 else { return nil }
+        let a = pts[r.lo].pt, b = pts[r.hi].pt
+        let abx = b.x - a.x, aby = b.y - a.y
+        let len2 = abx * abx + aby * aby
+        var best = -1.0, bestIndex = r.lo + 1
+        for i in (r.lo + 1)..<r.hi {
+            let p = pts[i].pt
+            var dx = p.x - a.x, dy = p.y - a.y
+            if len2 > 0 {
+                let t = min(max((dx * abx + dy * aby) / len2, 0), 1)
+                dx -= t * abx
+                dy -= t * aby
+            }
+            let d = dx * dx + dy * dy
+            if d > best {
+                best = d
+                bestIndex = i
+            }
+        }
+        let s = min(best.squareRoot(), r.cap)
+        sig[bestIndex] = s
+        return (Span(lo: r.lo, hi: bestIndex, cap: s), Span(lo: bestIndex, hi: r.hi, cap: s))
+    }
+}
@@ -0,0 +1,148 @@
+//
+//  TrackLengthTable.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import Accelerate
+import GLMap
+
+/// Cumulative length table of a polyline and batch sampling on top of it, the linear-time counterpart of
+/// `GLMapTrackData sample:count:result:`.
+///
+/// Locations are walked in sorted order against the table, so sampling m locations on n points costs
+/// O(n + m) plus a sort when the locations are not already ascending. Interpolation and directions are
+/// computed with vDSP gathers over per-segment columns.
+final class TrackLengthTable {
+    private static let chunk = 1024
+
+    let points: [GLMapPoint]
+
+    /// Meters from the first point to each point.
+    let prefix: [Double]
+
+    // Per-segment columns for the gathers: start point, delta to the end point, unit direction, length.
+    private lazy var columns: (ax: [Double], ay: [Double], dx: [Double], dy: [Double], ux: [Double], uy: [Double], meters: [Double]) = {
+        let n = max(points.count - 1, 0)
+        var ax = [Double](repeating: 0, count: n), ay = ax, dx = ax, dy = ax, ux = ax, uy = ax, meters = ax
+        for s in 0..<n {
+            let a = points[s], b = points[s + 1]
+            ax[s] = a.x
+            ay[s] = a.y
+            dx[s] = b.x - a.x
+            dy[s] = b.y - a.y
+            let len = (dx[s] * dx[s] + dy[s] * dy[s]).squareRoot()
+            ux[s] = len > 0 ? dx[s] / len : 0
+            uy[s] = len > 0 ? dy[s] / len : 0
+            // Zero-length segments never contain a location strictly inside, 1 keeps the division finite.
+            meters[s] = prefix[s + 1] > prefix[s] ? prefix[s + 1] - prefix[s] : 1
+        }
+        return (ax, ay, dx, dy, ux, uy, meters)
+    }()
+
+    var length: Double { prefix.last ?? 0 }
+    var segmentCount: Int { max(points.count - 1, 0) }
+
+    init(points: [GLMapPoint]) {
+        self.points = points
+        var prefix = [Double](repeating: 0, count: points.count)
+        for i in stride(from: 1, to: points.count, by: 1) {
+            prefix[i] = prefix[i - 1] + points[i - 1].distanceTo(points[i])
+        }
+        self.prefix = prefix
+    }
+
+    convenience init(track: [GLTrackPoint]) {
+        self.init(points: track.map { $0.pt })
+    }
+
+    /// Segment containing `distance` meters from the start and the fraction along it, clamped to the track.
+    func locate(_ distance: Double) -> (segment: Int, fraction: Double) {
+        guard segmentCount > 0 else { return (0, 0) }
+        var lo = 0, hi = prefix.count
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if prefix[mid] <= distance { lo = mid + 1 } else { hi = mid }
+        }
+        let s = min(max(lo - 1, 0), segmentCount - 1)
+        let span = prefix[s + 1] - prefix[s]
+        return (s, span > 0 ? min(max((distance - prefix[s]) / span, 0), 1) : 0)
+    }
+
+    // MARK: Sampling
+
+    /// Position and unit direction at each of `locations` (meters from the start), in input order.
+    func sample(_ locations: [Double]) -> [GLTrackSampleResult] {
+        let m = locations.count
+        guard m > 0, segmentCount > 0 else {
+            return Array(repeating: GLTrackSampleResult(position: points.first ?? GLMapPoint(x: 0, y: 0), direction: GLMapPoint(x: 0, y: 0)), count: m)
+        }
+
+        // Segment of every location by a merge walk over ascending locations.
+        var order: [vDSP_Length] = Array(0..<vDSP_Length(m))
+        if zip(locations, locations.dropFirst()).contains(where: { $0 > $1 }) {
+            locations.withUnsafeBufferPointer { vDSP_vsortiD($0.baseAddress!, &order, nil, vDSP_Length(m), 1) }
+        }
+        var segments = [vDSP_Length](repeating: 0, count: m)
+        var clamped = [Double](repeating: 0, count: m)
+        var s = 0
+        let last = segmentCount - 1
+        for k in order {
+            let loc = min(max(locations[Int(k)], 0), length)
+            while s < last && prefix[s + 1] <= loc {
+                s += 1
+            }
+            // vDSP gathers take 1-based indices.
+            segments[Int(k)] = vDSP_Length(s + 1)
+            clamped[Int(k)] = loc
+        }
+
+        var result = [GLTrackSampleResult](repeating: GLTrackSampleResult(), count: m)
+        let c = columns
+        let chunk = TrackLengthTable.chunk
+        // Scratch columns: ax, ay, dx, dy, ux, uy, meters, segment start, t.
+        let scratch = UnsafeMutablePointer<Double>.allocate(capacity: 9 * chunk)
+        defer { scratch.deallocate() }
+        let t = scratch + 8 * chunk
+
+        var lo = 0
+        while lo < m {
+            let n = min(chunk, m - lo)
+            let len = vDSP_Length(n)
+            segments.withUnsafeBufferPointer { seg in
+                let idx = seg.baseAddress! + lo
+                for (j, column) in [c.ax, c.ay, c.dx, c.dy, c.ux, c.uy, c.meters, prefix].enumerated() {
+                    vDSP_vgathrD(column, idx, 1, scratch + j * chunk, 1, len)
+                }
+            }
+            clamped.withUnsafeBufferPointer { loc in
+                // t = (location - segment start) / segment meters, then x = ax + t * dx, y = ay + t * dy.
+                vDSP_vsubD(scratch + 7 * chunk, 1, loc.baseAddress! + lo, 1, t, 1, len)
+            }
+            vDSP_vdivD(scratch + 6 * chunk, 1, t, 1, t, 1, len)
+            var zero = 0.0, one = 1.0
+            vDSP_vclipD(t, 1, &zero, &one, t, 1, len)
+            vDSP_vmaD(t, 1, scratch + 2 * chunk, 1, scratch, 1, scratch, 1, len)
+            vDSP_vmaD(t, 1, scratch + 3 * chunk, 1, scratch + chunk, 1, scratch + chunk, 1, len)
+
+            for i in 0..<n {
+                result[lo + i] = GLTrackSampleResult(position: GLMapPoint(x: scratch[i], y: scratch[chunk + i]),
+                                                     direction: GLMapPoint(x: scratch[4 * chunk + i], y: scratch[5 * chunk + i]))
+            }
+            lo += n
+        }
+        return result
+    }
+
+    /// Samples every `spacing` meters starting at `offset`, for arrows and repeated labels along a track.
+    func sample(every spacing: Double, offset: Double = 0) -> [GLTrackSampleResult] {
+        guard spacing > 0, offset <= length else { return [] }
+        let count = Int(((length - offset) / spacing).rounded(.down)) + 1
+        var locations = [Double](repeating: 0, count: count)
+        var from = offset, step = spacing
+        vDSP_vrampD(&from, &step, &locations, 1, vDSP_Length(count))
+        return sample(locations)
+    }
+}
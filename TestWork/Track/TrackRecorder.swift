@@ -0,0 +1,218 @@
+//
+//  TrackRecorder.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Live track that is appended in place and simplified as points arrive.
+///
+/// Each level keeps its own simplification with tolerance `baseTolerance * 2^level`, maintained by
+/// sleeve fitting: from the last kept point, the directions that pass within the tolerance of every
+/// point seen since form a wedge. A new point narrows the wedge in O(1); when its direction falls outside,
+/// the previous point is kept and becomes the new apex. Unlike Douglas–Peucker, nothing is ever
+/// re-scanned, so a point costs O(levels) however long the track grows, and every dropped point stays
+/// within the tolerance of the line through the kept points around it.
+final class TrackRecorder {
+    /// Kept points per sealed run, close to the segment size the framework recommends for live tracks.
+    static let chunkSize = 128
+
+    private struct Run {
+        /// Positions in `Level.kept`. Neighbouring runs share their joint point.
+        let range: ClosedRange<Int>
+        let data: GLMapTrackData?
+    }
+
+    private struct Level {
+        let tolerance: Double
+        var kept: [Int32] = []
+        /// Last point inside the sleeve, kept when the next one falls outside.
+        var last = -1
+        var ref = 0.0
+        var lo = 0.0
+        var hi = 0.0
+        var wedge = false
+        var runs: [Run] = []
+        var tail: (count: Int, data: GLMapTrackData?)?
+    }
+
+    private(set) var points: [GLTrackPoint] = []
+    private var levels: [Level]
+
+    let baseTolerance: Double
+
+    var count: Int { points.count }
+    var levelCount: Int { levels.count }
+
+    /// - Parameters:
+    ///   - baseTolerance: Tolerance of level 0 in map units.
+    ///   - levelCount: Number of levels, each doubling the tolerance of the previous one.
+    init(baseTolerance: Double = TrackRecorder.tolerance(pixels: 1, zoomLevel: 20), levelCount: Int = 16) {
+        self.baseTolerance = baseTolerance
+        levels = (0..<max(1, levelCount)).map { Level(tolerance: baseTolerance * Double(1 << $0)) }
+    }
+
+    /// Map units covered by `pixels` screen points at `zoomLevel`, for 256-point tiles.
+    static func tolerance(pixels: Double, zoomLevel: Double) -> Double {
+        return Double(GLMapPointMax) / (256 * pow(2, zoomLevel)) * pixels
+    }
+
+    // MARK: Recording
+
+    func append(_ point: GLMapPoint, color: GLMapColor) {
+        append(GLTrackPoint(pt: point, color: color))
+    }
+
+    func append(_ point: GLTrackPoint) {
+        let index = points.count
+        points.append(point)
+        for i in 0..<levels.count {
+            feed(&levels[i], index)
+        }
+    }
+
+    func append<S: Sequence>(contentsOf newPoints: S) where S.Element == GLTrackPoint {
+        points.reserveCapacity(points.count + newPoints.underestimatedCount)
+        for p in newPoints {
+            append(p)
+        }
+    }
+
+    func removeAll() {
+        points.removeAll()
+        levels = levels.map { Level(tolerance: $0.tolerance) }
+    }
+
+    // MARK: Output
+
+    /// Coarsest level whose tolerance does not exceed `tolerance`.
+    func level(for tolerance: Double) -> Int {
+        var level = 0
+        while level + 1 < levels.count && levels[level + 1].tolerance <= tolerance {
+            level += 1
+        }
+        return level
+    }
+
+    /// Indices of the points kept at `level`, including the newest point.
+    func indices(level: Int) -> [Int] {
+        return indices(level: level, from: 0)
+    }
+
+    func points(level: Int) -> [GLTrackPoint] {
+        return indices(level: level).map { points[$0] }
+    }
+
+    /// Track data for the level matching `tolerance`, split into chunks to show as separate tracks.
+    ///
+    /// Runs of `chunkSize` kept points are sealed as the track grows, and two sealed runs of the same length
+    /// are merged into one, like carries in a binary counter. That leaves O(log n) chunks and rebuilds every
+    /// kept point O(log n) times over the whole recording. Sealed chunks are returned as the same objects
+    /// until they are merged; only the last chunk, from the end of the sealed runs to the newest point, is
+    /// rebuilt after an append, and it never holds more than `chunkSize + 1` points.
+    func trackChunks(tolerance: Double) -> [GLMapTrackData] {
+        let level = self.level(for: tolerance)
+        seal(level)
+        var result = levels[level].runs.compactMap { $0.data }
+        if let tail = levels[level].tail, tail.count == points.count {
+            if let data = tail.data {
+                result.append(data)
+            }
+            return result
+        }
+        let start = levels[level].runs.last?.range.upperBound ?? 0
+        let tail = indices(level: level, from: start)
+        // A lone joint is already the end of the last run.
+        let data = tail.count > 1 || start == 0 ? makeTrackData(tail) : nil
+        levels[level].tail = (points.count, data)
+        if let data = data {
+            result.append(data)
+        }
+        return result
+    }
+
+    /// Full-resolution track data, for export or when the framework's own simplification is wanted.
+    func fullTrackData() -> GLMapTrackData? {
+        guard !points.isEmpty else { return nil }
+        return points.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }
+    }
+
+    private func indices(level: Int, from start: Int) -> [Int] {
+        let l = levels[level]
+        var result = l.kept[min(start, l.kept.count)...].map { Int($0) }
+        if !points.isEmpty && points.count - 1 != result.last {
+            result.append(points.count - 1)
+        }
+        return result
+    }
+
+    private func seal(_ level: Int) {
+        let chunk = TrackRecorder.chunkSize
+        var end = levels[level].runs.last?.range.upperBound ?? 0
+        while levels[level].kept.count - 1 - end >= chunk {
+            var range = end...(end + chunk)
+            while let previous = levels[level].runs.last, previous.range.count == range.count {
+                levels[level].runs.removeLast()
+                range = previous.range.lowerBound...range.upperBound
+            }
+            let kept = levels[level].kept[range].map { Int($0) }
+            levels[level].runs.append(Run(range: range, data: makeTrackData(kept)))
+            end = range.upperBound
+        }
+    }
+
+    private func makeTrackData(_ indices: [Int]) -> GLMapTrackData? {
+        guard !indices.isEmpty else { return nil }
+        let selected = indices.map { points[$0] }
+        return selected.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }
+    }
+
+    // MARK: Sleeve
+
+    private func feed(_ level: inout Level, _ index: Int) {
+        guard let apex = level.kept.last.map({ Int($0) }) else {
+            level.kept.append(Int32(index))
+            level.last = index
+            return
+        }
+        let a = points[apex].pt, p = points[index].pt
+        let dx = p.x - a.x, dy = p.y - a.y
+        let d = (dx * dx + dy * dy).squareRoot()
+
+        // Within the tolerance of the apex whatever the direction of the kept line. It must not become
+        // `last`, whose direction has to stay inside the wedge.
+        if d <= level.tolerance {
+            return
+        }
+        let direction = atan2(dy, dx)
+        let half = asin(level.tolerance / d)
+
+        if !level.wedge {
+            level.ref = direction
+            level.lo = -half
+            level.hi = half
+            level.wedge = true
+            level.last = index
+            return
+        }
+
+        var theta = direction - level.ref
+        if theta > .pi { theta -= 2 * .pi } else if theta < -.pi { theta += 2 * .pi }
+
+        if theta >= level.lo && theta <= level.hi {
+            level.lo = max(level.lo, theta - half)
+            level.hi = min(level.hi, theta + half)
+            level.last = index
+            return
+        }
+
+        // The segment to `index` would leave some earlier point out of tolerance: keep the previous point
+        // and restart the wedge from it.
+        level.kept.append(Int32(level.last))
+        level.wedge = false
+        feed(&level, index)
+    }
+}
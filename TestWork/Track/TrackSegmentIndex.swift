@@ -0,0 +1,213 @@
+//
+//  TrackSegmentIndex.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Nearest point on a track, as returned by `TrackSegmentIndex`.
+struct TrackSnap {
+    /// Index of the segment's first point.
+    let segment: Int
+    /// Position along the segment, 0...1.
+    let fraction: Double
+    let point: GLMapPoint
+    /// Distance from the query point in map units.
+    let distance: Double
+    /// Meters from the start of the track to `point`.
+    let progress: Double
+}
+
+/// Segment index for snapping positions to a long track or route, the indexed counterpart of
+/// `findProgressByPoint:nearestPoint:`.
+///
+/// A static packed R-tree: segments are sorted along the Hilbert curve and grouped `nodeSize` at a time,
+/// level by level, into flat arrays. Nothing is built until the first query. A hinted query first checks
+/// the segments around the previous snap, which on a live update is nearly always the answer, and then
+/// only visits tree nodes that could beat it.
+final class TrackSegmentIndex {
+    private static let nodeSize = 16
+    private static let hintWindow = 16
+
+    let points: [GLMapPoint]
+    private lazy var lengths = TrackLengthTable(points: points)
+
+    private var built = false
+    private var boxes: [Double] = []
+    private var refs: [Int] = []
+    private var levelEnds: [Int] = []
+
+    var segmentCount: Int { max(points.count - 1, 0) }
+
+    init(points: [GLMapPoint]) {
+        self.points = points
+    }
+
+    convenience init(track: [GLTrackPoint]) {
+        self.init(points: track.map { $0.pt })
+    }
+
+    // MARK: Queries
+
+    func nearest(to point: GLMapPoint, maxDistance: Double = .infinity) -> TrackSnap? {
+        return nearest(to: point, hint: nil, maxDistance: maxDistance)
+    }
+
+    /// Nearest point on the track, `nil` if nothing is within `maxDistance` map units. Pass the previous
+    /// result as `hint` when tracking a moving position.
+    func nearest(to point: GLMapPoint, hint: TrackSnap?, maxDistance: Double = .infinity) -> TrackSnap? {
+        guard segmentCount > 0 else { return nil }
+        buildIfNeeded()
+
+        var best = maxDistance == .infinity ? Double.infinity : maxDistance * maxDistance
+        var bestSegment = -1
+        var bestT = 0.0
+
+        func test(_ s: Int) {
+            let (d, t) = segmentDistance(point, s)
+            if d < best || (d == best && bestSegment < 0) {
+                best = d
+                bestSegment = s
+                bestT = t
+            }
+        }
+
+        if let hint = hint {
+            let lo = max(hint.segment - TrackSegmentIndex.hintWindow, 0)
+            let hi = min(hint.segment + TrackSegmentIndex.hintWindow, segmentCount - 1)
+            if lo <= hi {
+                for s in lo...hi {
+                    test(s)
+                }
+            }
+        }
+
+        // Best-first over the tree, a min-heap of (box distance, node position).
+        var heap = DistanceHeap()
+        heap.push(0, boxes.count / 4 - 1)
+        while let (d, node) = heap.pop() {
+            if d > best { break }
+            if node < segmentCount {
+                test(refs[node])
+                continue
+            }
+            let level = levelEnds.firstIndex { node < $0 }!
+            let start = refs[node]
+            let end = min(start + TrackSegmentIndex.nodeSize, levelEnds[level - 1])
+            for child in start..<end {
+                let cd = boxDistance(point, child)
+                if cd <= best {
+                    heap.push(cd, child)
+                }
+            }
+        }
+
+        guard bestSegment >= 0 else { return nil }
+        let a = points[bestSegment], b = points[bestSegment + 1]
+        let p = GLMapPoint(x: a.x + (b.x - a.x) * bestT, y: a.y + (b.y - a.y) * bestT)
+        let prefix = lengths.prefix
+        let progress = prefix[bestSegment] + (prefix[bestSegment + 1] - prefix[bestSegment]) * bestT
+        return TrackSnap(segment: bestSegment, fraction: bestT, point: p, distance: best.squareRoot(), progress: progress)
+    }
+
+    // MARK: Build
+
+    private func buildIfNeeded() {
+        guard !built else { return }
+        built = true
+        let n = segmentCount
+
+        var order = Array(0..<n)
+        let keys = (0..<n).map { s -> UInt64 in
+            let a = points[s], b = points[s + 1]
+            return SpatialKey.hilbert(GLMapPoint(x: (a.x + b.x) / 2, y: (a.y + b.y) / 2), bits: 16)
+        }
+        order.sort { keys[$0] < keys[$1] }
+
+        boxes.reserveCapacity(n * 4 * 17 / 16 + 4)
+        for s in order {
+            let a = points[s], b = points[s + 1]
+            boxes += [min(a.x, b.x), min(a.y, b.y), max(a.x, b.x), max(a.y, b.y)]
+        }
+        refs = order
+        levelEnds = [n]
+
+        var levelStart = 0
+        var levelEnd = n
+        while levelEnd - levelStart > 1 {
+            var i = levelStart
+            while i < levelEnd {
+                var minX = Double.infinity, minY = Double.infinity, maxX = -Double.infinity, maxY = -Double.infinity
+                for c in i..<min(i + TrackSegmentIndex.nodeSize, levelEnd) {
+                    minX = min(minX, boxes[4 * c])
+                    minY = min(minY, boxes[4 * c + 1])
+                    maxX = max(maxX, boxes[4 * c + 2])
+                    maxY = max(maxY, boxes[4 * c + 3])
+                }
+                boxes += [minX, minY, maxX, maxY]
+                refs.append(i)
+                i += TrackSegmentIndex.nodeSize
+            }
+            levelStart = levelEnd
+            levelEnd = refs.count
+            levelEnds.append(levelEnd)
+        }
+    }
+
+    // MARK: Geometry
+
+    private func segmentDistance(_ p: GLMapPoint, _ s: Int) -> (Double, Double) {
+        let a = points[s], b = points[s + 1]
+        let abx = b.x - a.x, aby = b.y - a.y
+        let len2 = abx * abx + aby * aby
+        let t = len2 > 0 ? min(max(((p.x - a.x) * abx + (p.y - a.y) * aby) / len2, 0), 1) : 0
+        let dx = p.x - a.x - t * abx, dy = p.y - a.y - t * aby
+        return (dx * dx + dy * dy, t)
+    }
+
+    private func boxDistance(_ p: GLMapPoint, _ node: Int) -> Double {
+        let dx = max(boxes[4 * node] - p.x, 0, p.x - boxes[4 * node + 2])
+        let dy = max(boxes[4 * node + 1] - p.y, 0, p.y - boxes[4 * node + 3])
+        return dx * dx + dy * dy
+    }
+}
+
+/// Min-heap of (distance, id) pairs for best-first searches.
+struct DistanceHeap {
+    private var items: [(Double, Int)] = []
+
+    var isEmpty: Bool { items.isEmpty }
+
+    mutating func push(_ distance: Double, _ id: Int) {
+        items.append((distance, id))
+        var k = items.count - 1
+        while k > 0 {
+            let parent = (k - 1) / 2
+            guard items[k].0 < items[parent].0 else { break }
+            items.swapAt(k, parent)
+            k = parent
+        }
+    }
+
+    mutating func pop() -> (Double, Int)? {
+        guard let top = items.first else { return nil }
+        let last = items.removeLast()
+        if !items.isEmpty {
+            items[0] = last
+            var k = 0
+            while true {
+                let l = 2 * k + 1, r = l + 1
+                var m = k
+                if l < items.count && items[l].0 < items[m].0 { m = l }
+                if r < items.count && items[r].0 < items[m].0 { m = r }
+                guard m != k else { break }
+                items.swapAt(k, m)
+                k = m
+            }
+        }
+        return top
+    }
+}
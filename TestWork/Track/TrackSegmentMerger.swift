@@ -0,0 +1,166 @@
+//
+//  TrackSegmentMerger.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+
+/// Joins track segments whose end point is the start point of another, like
+/// `trackDataWithMergedSegments`, for the tens of thousands of short segments a day of recording produces.
+///
+/// Endpoints are first bucketed by key shard, each core taking a range of segments, and then matched
+/// through one hash table per shard, so each shard pairs its ends and starts independently on its own
+/// core; every endpoint falls in exactly one shard, so the links are written without locks. Chains are
+/// then walked from their heads in parallel. Closed loops have no head and are picked up afterwards,
+/// starting from their lowest segment.
+enum TrackSegmentMerger {
+    /// Chains of segment indices in merge order.
+    static func chains(_ segments: [[GLTrackPoint]], parallel: Bool = true) -> [[Int]] {
+        let n = segments.count
+        guard n > 0 else { return [] }
+        let shards = parallel ? max(1, ProcessInfo.processInfo.activeProcessorCount) : 1
+
+        // Bucket every endpoint by shard once, one range of segments per core.
+        var buckets = [[[Endpoint]]](repeating: [], count: shards)
+        buckets.withUnsafeMutableBufferPointer { buckets in
+            perform(shards, parallel) { r in
+                var local = [[Endpoint]](repeating: [], count: shards)
+                for i in (r * n / shards)..<((r + 1) * n / shards) {
+                    if let p = segments[i].last?.pt {
+                        let key = EndpointKey(p)
+                        local[key.shard(shards)].append(Endpoint(key: key, segment: i, isStart: false))
+                    }
+                    if let p = segments[i].first?.pt {
+                        let key = EndpointKey(p)
+                        local[key.shard(shards)].append(Endpoint(key: key, segment: i, isStart: true))
+                    }
+                }
+                buckets[r] = local
+            }
+        }
+
+        var next = [Int](repeating: -1, count: n)
+        var prev = [Int](repeating: -1, count: n)
+        next.withUnsafeMutableBufferPointer { next in
+            prev.withUnsafeMutableBufferPointer { prev in
+                perform(shards, parallel) { shard in
+                    var table: [EndpointKey: (ends: [Int], starts: [Int])] = [:]
+                    for r in 0..<shards {
+                        for endpoint in buckets[r][shard] {
+                            if endpoint.isStart {
+                                table[endpoint.key, default: ([], [])].starts.append(endpoint.segment)
+                            } else {
+                                table[endpoint.key, default: ([], [])].ends.append(endpoint.segment)
+                            }
+                        }
+                    }
+                    // Pair ends with starts in index order through a cursor, never a segment with itself.
+                    for (_, entry) in table where !entry.ends.isEmpty && !entry.starts.isEmpty {
+                        var starts = entry.starts
+                        var cursor = 0
+                        for e in entry.ends where cursor < starts.count {
+                            if starts[cursor] == e {
+                                guard cursor + 1 < starts.count else { continue }
+                                starts.swapAt(cursor, cursor + 1)
+                            }
+                            next[e] = starts[cursor]
+                            prev[starts[cursor]] = e
+                            cursor += 1
+                        }
+                    }
+                }
+            }
+        }
+
+        let links = next
+        let heads = (0..<n).filter { prev[$0] < 0 }
+        var result = [[Int]](repeating: [], count: heads.count)
+        var visited = [Bool](repeating: false, count: n)
+        result.withUnsafeMutableBufferPointer { result in
+            visited.withUnsafeMutableBufferPointer { visited in
+                perform(heads.count, parallel) { h in
+                    var chain: [Int] = []
+                    var s = heads[h]
+                    while s >= 0 && !visited[s] {
+                        visited[s] = true
+                        chain.append(s)
+                        s = links[s]
+                    }
+                    result[h] = chain
+                }
+            }
+        }
+
+        for i in 0..<n where !visited[i] {
+            var chain: [Int] = []
+            var s = i
+            while s >= 0 && !visited[s] {
+                visited[s] = true
+                chain.append(s)
+                s = links[s]
+            }
+            result.append(chain)
+        }
+        return result
+    }
+
+    /// Merged point runs. The shared point at each joint appears once.
+    static func merge(_ segments: [[GLTrackPoint]], parallel: Bool = true) -> [[GLTrackPoint]] {
+        let chains = self.chains(segments, parallel: parallel)
+        var result = [[GLTrackPoint]](repeating: [], count: chains.count)
+        result.withUnsafeMutableBufferPointer { result in
+            perform(chains.count, parallel) { c in
+                var points: [GLTrackPoint] = []
+                points.reserveCapacity(chains[c].reduce(0) { $0 + segments[$1].count })
+                for s in chains[c] {
+                    points += points.isEmpty ? segments[s][...] : segments[s].dropFirst()
+                }
+                result[c] = points
+            }
+        }
+        return result
+    }
+
+    /// Merged runs as one multi-line object.
+    static func makeLine(_ segments: [[GLTrackPoint]], parallel: Bool = true) -> GLMapVectorLine {
+        let lines = merge(segments, parallel: parallel).map { run in
+            GLMapPointArray(count: UInt(run.count)) { run[Int($0)].pt }
+        }
+        return GLMapVectorLine(lines: lines)
+    }
+
+    private static func perform(_ iterations: Int, _ parallel: Bool, _ body: (Int) -> Void) {
+        if parallel {
+            DispatchQueue.concurrentPerform(iterations: iterations, execute: body)
+        } else {
+            for i in 0..<iterations {
+                body(i)
+            }
+        }
+    }
+}
+
+private struct Endpoint {
+    let key: EndpointKey
+    let segment: Int
+    let isStart: Bool
+}
+
+/// Exact endpoint identity, by bit pattern.
+private struct EndpointKey: Hashable {
+    let x: UInt64
+    let y: UInt64
+
+    init(_ p: GLMapPoint) {
+        x = p.x.bitPattern
+        y = p.y.bitPattern
+    }
+
+    func shard(_ count: Int) -> Int {
+        let h = (x &* 0x9E37_79B9_7F4A_7C15) ^ (y &* 0xC2B2_AE3D_27D4_EB4F)
+        return Int((h >> 32) % UInt64(count))
+    }
+}
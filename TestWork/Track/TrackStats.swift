@@ -0,0 +1,204 @@
+//
+//  TrackStats.swift
+//  TestWork
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import Accelerate
+import GLMap
+
+/// Summary of a recorded track for history screens: length, duration, speeds, climbing and an
+/// elevation profile.
+///
+/// Everything comes out of one pass over the points. Elevations are looked up `chunk` points at a time
+/// with `GLMapManager samplePoints:count:elevation:slope:` after a `GeoBatch` conversion, and profile marks
+/// every `profileSpacing` meters are interpolated on the segments they fall on while walking and looked up
+/// in batches as well.
+struct TrackStats {
+    /// Fills `elevation[0..<count]` for `points[0..<count]`, NaN where there is no data.
+    typealias ElevationLookup = (_ points: inout [GLMapGeoPoint], _ count: Int, _ elevation: inout [Float]) -> Void
+
+    struct ProfileSample {
+        /// Meters from the start of the track.
+        let distance: Double
+        /// Meters above sea level.
+        let elevation: Float
+    }
+
+    private static let chunk = 4096
+    /// Slower than this counts as standing, m/s.
+    static let movingSpeed = 0.5
+    /// Elevation changes below this are treated as DEM noise, meters.
+    static let climbThreshold: Float = 3
+
+    /// Meters.
+    let length: Double
+    /// Seconds from the first point to the last.
+    let duration: TimeInterval
+    /// Seconds spent above `movingSpeed`.
+    let movingDuration: TimeInterval
+    /// Speeds in m/s, percentiles weighted by the time spent at each speed.
+    let medianSpeed: Double
+    let p90Speed: Double
+    let maxSpeed: Double
+    /// Meters climbed and descended, `nil` when no elevation data is downloaded for the area.
+    let ascent: Double?
+    let descent: Double?
+    let profileSpacing: Double
+    let profile: [ProfileSample]
+
+    /// Stats for `range` of the track, the whole track by default.
+    init(track: TimedTrack, range: Range<Int>? = nil, profileSpacing: Double = 100,
+         elevations: ElevationLookup = TrackStats.downloadedElevations) {
+        let range = range ?? 0..<track.count
+        let points = track.points, times = track.times, distances = track.distances
+        let chunk = TrackStats.chunk
+        self.profileSpacing = profileSpacing
+
+        var speeds: [Double] = []
+        var weights: [Double] = []
+        speeds.reserveCapacity(range.count)
+        weights.reserveCapacity(range.count)
+        var moving = 0.0, maxSpeed = 0.0
+        var climb = Climb()
+        var profile: [ProfileSample] = []
+
+        var mapChunk = [GLMapPoint](repeating: GLMapPoint(x: 0, y: 0), count: chunk)
+        var geo = [GLMapGeoPoint](repeating: GLMapGeoPoint(lat: 0, lon: 0), count: chunk)
+        var elevation = [Float](repeating: .nan, count: chunk)
+        var marks: [GLMapPoint] = []
+        var markDistances: [Double] = []
+        var nextMark = range.isEmpty ? 0 : distances[range.lowerBound]
+
+        var lo = range.lowerBound
+        while lo < range.upperBound {
+            let n = min(chunk, range.upperBound - lo)
+            for k in 0..<n {
+                mapChunk[k] = points[lo + k].pt
+            }
+            GeoBatch.geoPoints(from: mapChunk, into: &geo, count: n)
+            elevations(&geo, n, &elevation)
+
+            for k in 0..<n {
+                let i = lo + k
+                climb.add(elevation[k])
+                let first = i == range.lowerBound
+                if !first {
+                    let dt = times[i] - times[i - 1]
+                    if dt > 0 {
+                        let v = (distances[i] - distances[i - 1]) / dt
+                        speeds.append(v)
+                        weights.append(dt)
+                        maxSpeed = max(maxSpeed, v)
+                        if v >= TrackStats.movingSpeed {
+                            moving += dt
+                        }
+                    }
+                }
+                // Profile marks on the segment ending at this point.
+                while profileSpacing > 0 && nextMark <= distances[i] {
+                    var p = points[i].pt
+                    let span = first ? 0 : distances[i] - distances[i - 1]
+                    if span > 0 {
+                        let a = points[i - 1].pt
+                        let t = (nextMark - distances[i - 1]) / span
+                        p = GLMapPoint(x: a.x + (p.x - a.x) * t, y: a.y + (p.y - a.y) * t)
+                    }
+                    marks.append(p)
+                    markDistances.append(nextMark - distances[range.lowerBound])
+                    nextMark += profileSpacing
+                }
+            }
+            lo += n
+
+            if marks.count >= chunk || lo == range.upperBound {
+                var markGeo = GeoBatch.geoPoints(from: marks)
+                var values = [Float](repeating: .nan, count: marks.count)
+                elevations(&markGeo, marks.count, &values)
+                for (d, e) in zip(markDistances, values) where Climb.isValid(e) {
+                    profile.append(ProfileSample(distance: d, elevation: e))
+                }
+                marks.removeAll(keepingCapacity: true)
+                markDistances.removeAll(keepingCapacity: true)
+            }
+        }
+
+        if let first = range.first, let last = range.last {
+            length = distances[last] - distances[first]
+            duration = times[last] - times[first]
+        } else {
+            length = 0
+            duration = 0
+        }
+        let percentiles = TrackStats.percentiles(speeds, weights, [0.5, 0.9])
+        medianSpeed = percentiles[0]
+        p90Speed = percentiles[1]
+        self.maxSpeed = maxSpeed
+        movingDuration = moving
+        ascent = climb.reference == nil ? nil : climb.ascent
+        descent = climb.reference == nil ? nil : climb.descent
+        self.profile = profile
+    }
+
+    // MARK: Helpers
+
+    /// Batch lookup in the downloaded elevation data; points without data come back as NaN.
+    static func downloadedElevations(_ points: inout [GLMapGeoPoint], _ count: Int, _ elevation: inout [Float]) {
+        guard count > 0 else { return }
+        if !GLMapManager.shared.samplePoints(&points, count: count, elevation: &elevation, slope: nil) {
+            for k in 0..<count {
+                elevation[k] = .nan
+            }
+        }
+    }
+
+    /// Time-weighted percentiles of `values`, `ps` ascending in 0...1.
+    private static func percentiles(_ values: [Double], _ weights: [Double], _ ps: [Double]) -> [Double] {
+        guard !values.isEmpty else { return ps.map { _ in 0 } }
+        var order: [vDSP_Length] = Array(0..<vDSP_Length(values.count))
+        vDSP_vsortiD(values, &order, nil, vDSP_Length(values.count), 1)
+        var total = 0.0
+        vDSP_sveD(weights, 1, &total, vDSP_Length(weights.count))
+
+        var result: [Double] = []
+        var sum = 0.0
+        var k = 0
+        for p in ps {
+            while k < order.count - 1 && sum + weights[Int(order[k])] < p * total {
+                sum += weights[Int(order[k])]
+                k += 1
+            }
+            result.append(values[Int(order[k])])
+        }
+        return result
+    }
+}
+
+/// Ascent and descent with a dead band, so DEM noise on flat ground does not add up.
+private struct Climb {
+    var reference: Float?
+    var ascent = 0.0
+    var descent = 0.0
+
+    static func isValid(_ e: Float) -> Bool {
+        return e.isFinite && e > Float(Int16.min)
+    }
+
+    mutating func add(_ e: Float) {
+        guard Climb.isValid(e) else { return }
+        guard let r = reference else {
+            reference = e
+            return
+        }
+        if e - r >= TrackStats.climbThreshold {
+            ascent += Double(e - r)
+            reference = e
+        } else if r - e >= TrackStats.climbThreshold {
+            descent += Double(r - e)
+            reference = e
+        }
+    }
+}
+
@@ -22,7 +22,7 @@ class ViewController: UIViewController {
     @IBOutlet weak var minusZoomButton: UIButton!
     
     var currentSelectUser = 0
-    let lock = NSRecursiveLock()
+    let userIndex = ConcurrentMapPointIndex()
     
     var bottomVC: BottomViewViewController!
     
@@ -74,6 +74,7 @@ class ViewController: UIViewController {
         super.viewWillAppear(animated)
         
         mapHelper.addUserMap(userList: userList)
+        updateUserIndex()
         addChildVC()
     }
     
@@ -92,18 +93,28 @@ class ViewController: UIViewController {
         }
     }
     
+    private func updateUserIndex() {
+        userIndex.reset(items: userList.enumerated().map { index, user in
+            MapPointIndex.Item(point: GLMapPoint(lat: user.coordinate?.lat ?? 0.0, lon: user.coordinate?.lon ?? 0.0), payload: UInt64(index))
+        })
+    }
+    
     private func findUser(point: CGPoint, mapView: GLMapView) -> User? {
         var userSelect: User?
-        lock.lock()
+        var bestDistance = Double.infinity
 
         let rect = CGRect(x: -30, y: +20, width: 60, height: 60).offsetBy(dx: point.x, dy: point.y)
+        let center = mapView.makeMapPoint(fromDisplay: CGPoint(x: rect.midX, y: rect.midY))
+        let delta = mapView.makeMapPoint(fromDisplayDelta: CGPoint(x: rect.width / 2, y: rect.height / 2))
+        let radius = (delta.x * delta.x + delta.y * delta.y).squareRoot()
         
-        userList.forEach { user in
-            if rect.contains(mapView.makeDisplayPoint(from: GLMapPoint(lat: user.coordinate?.lat ?? 0.0, lon: user.coordinate?.lon ?? 0.0))) {
-                userSelect = user
+        userIndex.forEachItem(within: radius, of: center) { item in
+            let distance = distanceSquared(item.point, center)
+            if distance < bestDistance && Int(item.payload) < userList.count && rect.contains(mapView.makeDisplayPoint(from: item.point)) {
+                bestDistance = distance
+                userSelect = userList[Int(item.payload)]
             }
         }
-        lock.unlock()
         return userSelect
     }
 }
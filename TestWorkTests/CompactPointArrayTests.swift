@@ -0,0 +1,155 @@
+//
+//  CompactPointArrayTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class CompactPointArrayTests: XCTestCase {
+    private let w = Double(GLMapPointMax)
+
+    /// A walk with a few teleports, so `delta16` has to escape some points.
+    private func track(_ count: Int) -> [GLMapPoint] {
+        var points = TestData.walk(count, step: 3)
+        for i in stride(from: 1_000, to: count, by: 7_919) {
+            points[i] = GLMapPoint(x: points[i].x + 1e6, y: points[i].y - 1e6)
+        }
+        return points
+    }
+
+    func testGridConversionRoundsAndIsLossless() {
+        var rng = SeededGenerator(seed: 110)
+        for p in TestData.mapPoints(10_000, seed: 111) {
+            let q = MapPointI(p)
+            XCTAssertLessThanOrEqual(abs(q.mapPoint.x - p.x), 0.5)
+            XCTAssertLessThanOrEqual(abs(q.mapPoint.y - p.y), 0.5)
+            XCTAssertEqual(MapPointI(q.mapPoint), q)
+            XCTAssertEqual(MapPointI(exactly: q.mapPoint), q)
+        }
+        for _ in 0..<1_000 {
+            let p = GLMapPoint(x: Double(Int32.random(in: 0..<GLMapPointMax, using: &rng)) + 0.25,
+                               y: Double(Int32.random(in: 0..<GLMapPointMax, using: &rng)))
+            XCTAssertNil(MapPointI(exactly: p))
+        }
+    }
+
+    func testXWrapsAroundTheWorld() {
+        let p = GLMapPoint(lat: -17.7, lon: 178.0)
+        let q = MapPointI(p)
+        XCTAssertEqual(MapPointI(GLMapPoint(x: p.x + w, y: p.y)), q)
+        XCTAssertEqual(MapPointI(GLMapPoint(x: p.x - w, y: p.y)), q)
+        XCTAssertEqual(MapPointI(GLMapPoint(x: p.x - 3 * w, y: p.y)), q)
+        // Just east of the dateline in the next world copy is the western edge, not the clamped border.
+        let east = MapPointI(GLMapPoint(x: w + 10, y: p.y))
+        XCTAssertEqual(east.x, 10)
+        XCTAssertEqual(MapPointI(GLMapPoint(x: -10, y: p.y)).x, GLMapPointMax - 10)
+        XCTAssertEqual(MapPointI(GLMapPoint(x: w, y: 0)).x, 0)
+    }
+
+    func testEncodingsDecodeTheSamePoints() {
+        let points = track(20_000)
+        let int32 = CompactPointArray(points, encoding: .int32)
+        let delta16 = CompactPointArray(points, encoding: .delta16)
+        XCTAssertEqual(int32.count, points.count)
+        XCTAssertEqual(delta16.count, points.count)
+
+        var decoded: [MapPointI] = []
+        delta16.forEach { decoded.append($0) }
+        var expected: [MapPointI] = []
+        int32.forEach { expected.append($0) }
+        XCTAssertEqual(decoded, expected)
+        XCTAssertEqual(expected, points.map { MapPointI($0) })
+
+        var rng = SeededGenerator(seed: 112)
+        for _ in 0..<2_000 {
+            let i = Int.random(in: 0..<points.count, using: &rng)
+            XCTAssertEqual(delta16.pointI(at: i), expected[i])
+            XCTAssertEqual(int32[i].x, expected[i].mapPoint.x)
+        }
+    }
+
+    func testFrameworkObjectsMatch() {
+        let points = track(5_000)
+        for encoding in [CompactPointArray.Encoding.int32, .delta16] {
+            let compact = CompactPointArray(points, encoding: encoding)
+            let array = compact.makePointArray()
+            XCTAssertEqual(Int(array.count), points.count)
+            for i in stride(from: 0, to: points.count, by: 13) {
+                let p = array.point(at: UInt(i))
+                XCTAssertEqual(p.x, compact[i].x)
+                XCTAssertEqual(p.y, compact[i].y)
+            }
+            XCTAssertNotNil(compact.makeTrackData(color: GLMapColor(red: 255, green: 0, blue: 0, alpha: 255)))
+        }
+        XCTAssertNil(CompactPointArray().makeTrackData(color: GLMapColor(red: 255, green: 0, blue: 0, alpha: 255)))
+    }
+
+    // MARK: Benchmarks, 1M points
+
+    private lazy var million = track(1_000_000)
+
+    func testMemoryFootprint() {
+        let raw = million.count * MemoryLayout<GLMapPoint>.stride
+        let int32 = CompactPointArray(million, encoding: .int32).byteCount
+        let delta16 = CompactPointArray(million, encoding: .delta16).byteCount
+        print("1M points: GLMapPoint \(raw) B, int32 \(int32) B, delta16 \(delta16) B")
+        XCTAssertEqual(int32 * 2, raw)
+        XCTAssertLessThan(Double(delta16), Double(raw) * 0.27)
+    }
+
+    func testAppendInt32Performance() {
+        let points = million
+        measure {
+            XCTAssertEqual(CompactPointArray(points, encoding: .int32).count, points.count)
+        }
+    }
+
+    func testAppendDelta16Performance() {
+        let points = million
+        measure {
+            XCTAssertEqual(CompactPointArray(points, encoding: .delta16).count, points.count)
+        }
+    }
+
+    /// Baseline for the decode benchmarks: summing plain `GLMapPoint`s.
+    func testScanRawPerformance() {
+        let points = million
+        measure {
+            var sum = 0.0
+            for p in points {
+                sum += p.x + p.y
+            }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    func testScanInt32Performance() {
+        let compact = CompactPointArray(million, encoding: .int32)
+        measure {
+            var sum = 0.0
+            compact.forEach { sum += Double($0.x) + Double($0.y) }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    func testScanDelta16Performance() {
+        let compact = CompactPointArray(million, encoding: .delta16)
+        measure {
+            var sum = 0.0
+            compact.forEach { sum += Double($0.x) + Double($0.y) }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    func testMakeTrackDataDelta16Performance() {
+        let compact = CompactPointArray(million, encoding: .delta16)
+        let color = GLMapColor(red: 255, green: 0, blue: 0, alpha: 255)
+        measure {
+            XCTAssertNotNil(compact.makeTrackData(color: color))
+        }
+    }
+}
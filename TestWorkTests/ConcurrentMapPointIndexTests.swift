@@ -0,0 +1,224 @@
+//
+//  ConcurrentMapPointIndexTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class ConcurrentMapPointIndexTests: XCTestCase {
+    private let center = GLMapPoint(lat: 52.52, lon: 13.40)
+    private let users = 2_000
+
+    private func initialItems() -> [MapPointIndex.Item] {
+        return TestData.mapPoints(users, around: center, spread: 50_000).enumerated().map {
+            MapPointIndex.Item(point: $1, payload: UInt64($0))
+        }
+    }
+
+    /// Moves user `id` the way the ingestion thread does: remove and insert in one published update.
+    private func move(_ index: ConcurrentMapPointIndex, _ positions: inout [GLMapPoint], _ id: Int, to p: GLMapPoint) {
+        let old = positions[id]
+        index.update { next in
+            next.remove(payload: UInt64(id), at: old)
+            next.insert(p, payload: UInt64(id))
+        }
+        positions[id] = p
+    }
+
+    func testSnapshotIsImmutable() {
+        let items = initialItems()
+        let index = ConcurrentMapPointIndex(index: MapPointIndex(items: items))
+        let before = index.snapshot()
+        var positions = items.map { $0.point }
+        move(index, &positions, 0, to: center)
+        XCTAssertEqual(before.nearestItem(to: items[0].point)?.point.x, items[0].point.x)
+        XCTAssertEqual(index.snapshot().nearestItem(to: center)?.payload, 0)
+        XCTAssertEqual(before.count, users)
+        XCTAssertEqual(index.snapshot().count, users)
+    }
+
+    /// One writer moves users while readers check every snapshot they get: all users present exactly once
+    /// and the snapshot unchanged between two queries.
+    func testStressOneWriterManyReaders() {
+        let items = initialItems()
+        let index = ConcurrentMapPointIndex(index: MapPointIndex(items: items))
+        let readerCount = max(2, ProcessInfo.processInfo.activeProcessorCount - 1)
+        let moves = 20_000
+        let failures = Counter()
+        let done = Flag()
+
+        runThreads(readerCount + 1) { worker in
+            if worker == 0 {
+                var rng = SeededGenerator(seed: 30)
+                var positions = items.map { $0.point }
+                for step in 0..<moves {
+                    if step % 5_000 == 4_999 {
+                        index.reset(items: positions.enumerated().map { MapPointIndex.Item(point: $1, payload: UInt64($0)) })
+                        continue
+                    }
+                    let id = Int.random(in: 0..<self.users, using: &rng)
+                    let p = GLMapPoint(x: positions[id].x + Double.random(in: -500...500, using: &rng),
+                                       y: positions[id].y + Double.random(in: -500...500, using: &rng))
+                    self.move(index, &positions, id, to: p)
+                }
+                done.set()
+                return
+            }
+            var rng = SeededGenerator(seed: UInt64(100 + worker))
+            while !done.isSet {
+                let snapshot = index.snapshot()
+                let users = self.users
+                var seen = [Bool](repeating: false, count: users)
+                var total = 0
+                snapshot.forEachItem(within: 1e9, of: self.center) { item in
+                    total += 1
+                    let id = Int(item.payload)
+                    if id < users && !seen[id] {
+                        seen[id] = true
+                    } else {
+                        failures.add()
+                    }
+                }
+                if total != users || snapshot.count != users {
+                    failures.add()
+                }
+                let q = TestData.mapPoints(1, around: self.center, spread: 50_000, seed: rng.next())[0]
+                let first = snapshot.nearestItems(to: q, k: 8).map { $0.payload }
+                if first != snapshot.nearestItems(to: q, k: 8).map({ $0.payload }) || first.count != 8 {
+                    failures.add()
+                }
+            }
+        }
+        XCTAssertEqual(failures.value, 0)
+        XCTAssertEqual(index.snapshot().count, users)
+    }
+
+    func testReleasesReplacedVersions() {
+        weak var first: MapPointIndex?
+        let index: ConcurrentMapPointIndex = {
+            let initial = MapPointIndex(items: initialItems())
+            first = initial
+            return ConcurrentMapPointIndex(index: initial)
+        }()
+        XCTAssertNotNil(first)
+        index.update { $0.insert(center) }
+        XCTAssertNil(first)
+    }
+
+    // MARK: Contention benchmark, 1 writer and N readers
+
+    private func measureContention(readers: Int, locked: Bool) {
+        let items = initialItems()
+        let queries = TestData.mapPoints(2_000, around: center, spread: 50_000, seed: 31)
+        let radius = 500 * MapPointIndex.mapUnitsPerMeter(at: center)
+        measure {
+            let concurrent = ConcurrentMapPointIndex(index: MapPointIndex(items: items))
+            // Baseline: the single index behind a mutex that ViewController used before.
+            let plain = MapPointIndex(items: items)
+            let lock = NSLock()
+            runThreads(readers + 1) { worker in
+                if worker == 0 {
+                    var positions = items.map { $0.point }
+                    for step in 0..<2_000 {
+                        let id = step * 7 % self.users
+                        let p = positions[id].add(x: 100, y: -100)
+                        if locked {
+                            lock.lock()
+                            plain.remove(payload: UInt64(id), at: positions[id])
+                            plain.insert(p, payload: UInt64(id))
+                            lock.unlock()
+                            positions[id] = p
+                        } else {
+                            self.move(concurrent, &positions, id, to: p)
+                        }
+                    }
+                    return
+                }
+                var found = 0
+                for q in queries {
+                    if locked {
+                        lock.lock()
+                        found += plain.nearestItems(to: q, k: 10).count
+                        plain.forEachItem(within: radius, of: q) { _ in found += 1 }
+                        lock.unlock()
+                    } else {
+                        let snapshot = concurrent.snapshot()
+                        found += snapshot.nearestItems(to: q, k: 10).count
+                        snapshot.forEachItem(within: radius, of: q) { _ in found += 1 }
+                    }
+                }
+                XCTAssertGreaterThan(found, 0)
+            }
+        }
+    }
+
+    func testContention1Reader() { measureContention(readers: 1, locked: false) }
+    func testContention4Readers() { measureContention(readers: 4, locked: false) }
+    func testContention8Readers() { measureContention(readers: 8, locked: false) }
+    func testLockedBaseline1Reader() { measureContention(readers: 1, locked: true) }
+    func testLockedBaseline4Readers() { measureContention(readers: 4, locked: true) }
+    func testLockedBaseline8Readers() { measureContention(readers: 8, locked: true) }
+
+    func testSingleUpdatePerformance() {
+        let index = ConcurrentMapPointIndex(index: MapPointIndex(points: TestData.mapPoints(1_000_000, seed: 32)))
+        let points = TestData.mapPoints(1_000, seed: 33)
+        measure {
+            for p in points {
+                index.update { $0.insert(p) }
+            }
+        }
+    }
+}
+
+/// Runs `body(0..<count)` on `count` dedicated threads and waits for all of them. Unlike
+/// `concurrentPerform`, every body really runs at the same time, so bodies may wait for each other.
+private func runThreads(_ count: Int, _ body: @escaping (Int) -> Void) {
+    let group = DispatchGroup()
+    for i in 0..<count {
+        group.enter()
+        let thread = Thread {
+            body(i)
+            group.leave()
+        }
+        thread.start()
+    }
+    group.wait()
+}
+
+private final class Counter {
+    private let lock = NSLock()
+    private var count = 0
+
+    var value: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return count
+    }
+
+    func add() {
+        lock.lock()
+        count += 1
+        lock.unlock()
+    }
+}
+
+private final class Flag {
+    private let lock = NSLock()
+    private var flag = false
+
+    var isSet: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return flag
+    }
+
+    func set() {
+        lock.lock()
+        flag = true
+        lock.unlock()
+    }
+}
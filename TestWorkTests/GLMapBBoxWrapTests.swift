@@ -0,0 +1,163 @@
+//
+//  GLMapBBoxWrapTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+/// Randomized properties of the wrap-aware box algebra, with most boxes near or across ±180°.
+final class GLMapBBoxWrapTests: XCTestCase {
+    private let w = GLMapBBox.worldWidth
+    // Coordinates are around 1e9, so this is a few ulps of slack.
+    private let eps = 1e-3
+
+    private func randomBox(_ rng: inout SeededGenerator) -> GLMapBBox {
+        // Origins within 1/8 of the world around the dateline, written in any of the three world copies.
+        let x = Double.random(in: -w / 8...w / 8, using: &rng) + w * Double(Int.random(in: -1...1, using: &rng))
+        let width: Double
+        switch Int.random(in: 0..<10, using: &rng) {
+        case 0: width = 0
+        case 1: width = Double.random(in: w / 2...w, using: &rng)
+        default: width = Double.random(in: 0...w / 6, using: &rng)
+        }
+        // A narrow latitude band, so the y extents overlap often and x decides.
+        let y = Double.random(in: w * 0.45...w * 0.5, using: &rng)
+        return GLMapBBox(origin: GLMapPoint(x: x, y: y), width: width,
+                         height: Double.random(in: 0...w * 0.05, using: &rng))
+    }
+
+    private func folded(_ x: Double) -> Double {
+        var r = x.truncatingRemainder(dividingBy: w)
+        if r < 0 { r += w }
+        return r
+    }
+
+    /// Whether the x arc of `inner` lies inside the x arc of `outer` on the circle, and likewise for y.
+    private func covers(_ outer: GLMapBBox, _ inner: GLMapBBox) -> Bool {
+        let o = outer.wrapNormalized, i = inner.wrapNormalized
+        guard i.origin.y >= o.origin.y - eps && i.origin.y + i.size.y <= o.origin.y + o.size.y + eps else {
+            return false
+        }
+        if o.size.x >= w - eps { return true }
+        for shift in [0, w, -w] {
+            let x = i.origin.x + shift
+            if x >= o.origin.x - eps && x + i.size.x <= o.origin.x + o.size.x + eps {
+                return true
+            }
+        }
+        return false
+    }
+
+    private func covers(_ outer: GLMapBBox, _ p: GLMapPoint) -> Bool {
+        return covers(outer, GLMapBBox(origin: p, width: 0, height: 0))
+    }
+
+    func testUnionContainsBothInputs() {
+        var rng = SeededGenerator(seed: 90)
+        for _ in 0..<20_000 {
+            let a = randomBox(&rng), b = randomBox(&rng)
+            let u = a.wrappedUnion(b)
+            XCTAssertTrue(covers(u, a), "\(a) ∪ \(b) = \(u)")
+            XCTAssertTrue(covers(u, b), "\(a) ∪ \(b) = \(u)")
+            XCTAssertTrue(u.origin.x >= 0 && u.origin.x < w)
+            // Never wider than going the plain way round.
+            let plain = max(a.origin.x + a.size.x, b.origin.x + b.size.x) - min(a.origin.x, b.origin.x)
+            XCTAssertLessThanOrEqual(u.size.x, min(plain, w) + eps)
+            XCTAssertEqual(u.size.x, b.wrappedUnion(a).size.x, accuracy: eps)
+        }
+    }
+
+    func testUnionWithEmpty() {
+        var rng = SeededGenerator(seed: 91)
+        for _ in 0..<1_000 {
+            let a = randomBox(&rng)
+            XCTAssertTrue(GLMapBBoxEqual(a.wrappedUnion(.empty), a.wrapNormalized))
+            XCTAssertTrue(GLMapBBoxEqual(GLMapBBox.empty.wrappedUnion(a), a.wrapNormalized))
+            XCTAssertNil(a.wrappedIntersection(.empty))
+        }
+    }
+
+    func testIntersectionContainedInBothInputs() {
+        var rng = SeededGenerator(seed: 92)
+        var found = 0
+        for _ in 0..<20_000 {
+            let a = randomBox(&rng), b = randomBox(&rng)
+            guard let i = a.wrappedIntersection(b) else {
+                XCTAssertFalse(a.wrappedIntersects(b), "\(a) ∩ \(b)")
+                XCTAssertFalse(covers(a, b) || covers(b, a), "\(a) ∩ \(b)")
+                continue
+            }
+            found += 1
+            XCTAssertTrue(covers(a, i), "\(a) ∩ \(b) = \(i)")
+            XCTAssertTrue(covers(b, i), "\(a) ∩ \(b) = \(i)")
+            XCTAssertTrue(a.wrappedIntersects(b))
+            XCTAssertLessThanOrEqual(i.area, min(a.wrapNormalized.area, b.wrapNormalized.area) * (1 + 1e-12) + eps)
+        }
+        // Make sure the generator actually produces overlaps.
+        XCTAssertGreaterThan(found, 1_000)
+    }
+
+    func testPointInBothBoxesImpliesIntersection() {
+        var rng = SeededGenerator(seed: 93)
+        for _ in 0..<20_000 {
+            let a = randomBox(&rng), b = randomBox(&rng)
+            let p = GLMapPoint(x: a.origin.x + a.size.x * Double.random(in: 0...1, using: &rng),
+                               y: a.origin.y + a.size.y * Double.random(in: 0...1, using: &rng))
+            if covers(b, p) {
+                XCTAssertNotNil(a.wrappedIntersection(b), "\(p) in \(a) and \(b)")
+                XCTAssertTrue(a.wrappedIntersects(b))
+            }
+        }
+    }
+
+    func testAddingGrowsTheShortWay() {
+        var rng = SeededGenerator(seed: 94)
+        for _ in 0..<5_000 {
+            let a = randomBox(&rng)
+            let p = GLMapPoint(x: Double.random(in: -w...2 * w, using: &rng), y: Double.random(in: 0...w, using: &rng))
+            let grown = a.wrappedAdding(p)
+            XCTAssertTrue(covers(grown, a))
+            XCTAssertTrue(covers(grown, p))
+            XCTAssertLessThanOrEqual(grown.size.x, a.wrapNormalized.size.x + w / 2 + eps)
+        }
+    }
+
+    func testMinimalSpanMatchesBruteForce() {
+        var rng = SeededGenerator(seed: 95)
+        for _ in 0..<500 {
+            let count = Int.random(in: 1...40, using: &rng)
+            let center = Double.random(in: -w / 4...w / 4, using: &rng)
+            let spread = Double.random(in: 0...w / 2, using: &rng)
+            let points = (0..<count).map { _ in
+                GLMapPoint(x: center + Double.random(in: -spread...spread, using: &rng),
+                           y: Double.random(in: 0...w, using: &rng))
+            }
+            let box = GLMapBBox(minimalSpanOf: points)
+            for p in points {
+                XCTAssertTrue(covers(box, p), "\(p) outside \(box)")
+            }
+            // Any box covering all points starts at one of them; try each start.
+            var best = w
+            for s in points {
+                let span = points.map { folded($0.x - s.x) }.max()!
+                best = min(best, span)
+            }
+            XCTAssertEqual(box.size.x, best, accuracy: eps)
+        }
+    }
+
+    func testDatelineFleetIsNarrow() {
+        // Points a few degrees either side of ±180°.
+        let geo = [GLMapGeoPoint(lat: -17.7, lon: 178.0), GLMapGeoPoint(lat: -18.1, lon: -179.5),
+                   GLMapGeoPoint(lat: -16.9, lon: 179.9), GLMapGeoPoint(lat: -14.3, lon: -171.8)]
+        let box = GLMapBBox(minimalSpanOf: geo.map { GLMapPoint(geoPoint: $0) })
+        XCTAssertEqual(box.size.x / w, 10.2 / 360, accuracy: 1e-9)
+        XCTAssertGreaterThan(box.origin.x + box.size.x, w)
+        let center = GLMapGeoPoint(point: box.wrappedCenter)
+        XCTAssertEqual(center.lon, -176.9, accuracy: 1e-6)
+    }
+}
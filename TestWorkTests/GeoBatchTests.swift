@@ -0,0 +1,112 @@
+//
+//  GeoBatchTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class GeoBatchTests: XCTestCase {
+    private let geo = TestData.geoPoints(100_000)
+
+    func testMapPointsMatchFramework() {
+        let batch = GeoBatch.mapPoints(from: geo)
+        var error = 0.0
+        for (g, p) in zip(geo, batch) {
+            let expected = GLMapPoint(lat: g.lat, lon: g.lon)
+            error = max(error, abs(p.x - expected.x), abs(p.y - expected.y))
+        }
+        XCTAssertLessThan(error, 1e-6)
+    }
+
+    func testGeoPointsMatchFramework() {
+        let points = geo.map { GLMapPoint(lat: $0.lat, lon: $0.lon) }
+        let batch = GeoBatch.geoPoints(from: points)
+        var error = 0.0
+        for (p, g) in zip(points, batch) {
+            let expected = GLMapGeoPoint(point: p)
+            error = max(error, abs(g.lat - expected.lat), abs(g.lon - expected.lon))
+        }
+        XCTAssertLessThan(error, 1e-9)
+    }
+
+    func testScalarPathAgreesWithBatchPath() {
+        let batch = GeoBatch.mapPoints(from: geo)
+        for i in stride(from: 0, to: geo.count, by: 97) {
+            let p = GeoBatch.mapPoint(from: geo[i])
+            XCTAssertEqual(p.x, batch[i].x, accuracy: 1e-9)
+            XCTAssertEqual(p.y, batch[i].y, accuracy: 1e-9)
+        }
+        let short = Array(geo.prefix(GeoBatch.scalarThreshold - 1))
+        for (p, q) in zip(GeoBatch.mapPoints(from: short), batch) {
+            XCTAssertEqual(p.x, q.x, accuracy: 1e-9)
+            XCTAssertEqual(p.y, q.y, accuracy: 1e-9)
+        }
+    }
+
+    func testInPlaceRoundTrip() {
+        var buffer = geo
+        buffer.withUnsafeMutableBufferPointer { b in
+            let base = b.baseAddress!
+            base.withMemoryRebound(to: GLMapPoint.self, capacity: b.count) { mapped in
+                GeoBatch.mapPoints(from: base, into: mapped, count: b.count)
+                GeoBatch.geoPoints(from: mapped, into: base, count: b.count)
+            }
+        }
+        var error = 0.0
+        for (a, b) in zip(geo, buffer) {
+            error = max(error, abs(a.lat - b.lat), abs(a.lon - b.lon))
+        }
+        XCTAssertLessThan(error, 1e-9)
+    }
+
+    func testEmptyInput() {
+        XCTAssertTrue(GeoBatch.mapPoints(from: []).isEmpty)
+        XCTAssertTrue(GeoBatch.geoPoints(from: []).isEmpty)
+    }
+
+    // MARK: Benchmarks, 1M points
+
+    private lazy var million = TestData.geoPoints(1_000_000, seed: 2)
+
+    func testPerPointConversionPerformance() {
+        let input = million
+        measure {
+            var result = [GLMapPoint]()
+            result.reserveCapacity(input.count)
+            for g in input {
+                result.append(GLMapPoint(lat: g.lat, lon: g.lon))
+            }
+            XCTAssertEqual(result.count, input.count)
+        }
+    }
+
+    func testBatchConversionPerformance() {
+        let input = million
+        measure {
+            XCTAssertEqual(GeoBatch.mapPoints(from: input).count, input.count)
+        }
+    }
+
+    func testPerPointInverseConversionPerformance() {
+        let input = GeoBatch.mapPoints(from: million)
+        measure {
+            var result = [GLMapGeoPoint]()
+            result.reserveCapacity(input.count)
+            for p in input {
+                result.append(GLMapGeoPoint(point: p))
+            }
+            XCTAssertEqual(result.count, input.count)
+        }
+    }
+
+    func testBatchInverseConversionPerformance() {
+        let input = GeoBatch.mapPoints(from: million)
+        measure {
+            XCTAssertEqual(GeoBatch.geoPoints(from: input).count, input.count)
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  GeoDistanceTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class GeoDistanceTests: XCTestCase {
+    private let origin = GLMapGeoPoint(lat: 52.52, lon: 13.40)
+    private let targets = TestData.geoPoints(10_000, lat: -80...80)
+
+    func testHaversineMatchesFramework() {
+        let d = GeoBatch.distances(from: origin, to: GeoPointColumns(targets))
+        var error = 0.0
+        for (t, v) in zip(targets, d) {
+            let expected = origin.distanceTo(t)
+            error = max(error, abs(v - expected) / max(expected, 1))
+        }
+        XCTAssertLessThan(error, 1e-6)
+    }
+
+    func testEquirectangularIsCloseAtShortRange() {
+        let near = TestData.geoPoints(10_000, lat: 52.3...52.7, lon: 13.1...13.7)
+        let d = GeoBatch.distances(from: origin, to: GeoPointColumns(near), accuracy: .equirectangular)
+        var error = 0.0
+        for (t, v) in zip(near, d) {
+            let expected = origin.distanceTo(t)
+            error = max(error, abs(v - expected) / max(expected, 1))
+        }
+        XCTAssertLessThan(error, 1e-3)
+    }
+
+    func testEquirectangularWrapsLongitude() {
+        let a = GLMapGeoPoint(lat: 0, lon: 179.9)
+        let b = GLMapGeoPoint(lat: 0, lon: -179.9)
+        let d = GeoBatch.distances(from: a, to: GeoPointColumns([b]), accuracy: .equirectangular)
+        XCTAssertEqual(d[0], a.distanceTo(b), accuracy: a.distanceTo(b) * 1e-3)
+    }
+
+    func testPairwiseMatchesOneToMany() {
+        let columns = GeoPointColumns(targets)
+        let origins = GeoPointColumns([GLMapGeoPoint](repeating: origin, count: targets.count))
+        XCTAssertEqual(GeoBatch.distances(between: origins, and: columns), GeoBatch.distances(from: origin, to: columns))
+        XCTAssertEqual(GeoBatch.bearings(between: origins, and: columns), GeoBatch.bearings(from: origin, to: columns))
+    }
+
+    func testBearings() {
+        let b = GeoBatch.bearings(from: GLMapGeoPoint(lat: 0, lon: 0),
+                                  to: GeoPointColumns([GLMapGeoPoint(lat: 1, lon: 0), GLMapGeoPoint(lat: 0, lon: 1),
+                                                       GLMapGeoPoint(lat: -1, lon: 0), GLMapGeoPoint(lat: 0, lon: -1)]))
+        XCTAssertEqual(b[0], 0, accuracy: 1e-9)
+        XCTAssertEqual(b[1], 90, accuracy: 1e-9)
+        XCTAssertEqual(b[2], 180, accuracy: 1e-9)
+        XCTAssertEqual(b[3], 270, accuracy: 1e-9)
+
+        let bearings = GeoBatch.bearings(from: origin, to: GeoPointColumns(targets))
+        var error = 0.0
+        for (t, v) in zip(targets, bearings) {
+            XCTAssertTrue((0..<360).contains(v))
+            let expected = referenceBearing(origin, t)
+            let diff = abs(v - expected).truncatingRemainder(dividingBy: 360)
+            error = max(error, min(diff, 360 - diff))
+        }
+        XCTAssertLessThan(error, 1e-6)
+    }
+
+    /// Textbook initial great-circle bearing, clockwise from north.
+    private func referenceBearing(_ a: GLMapGeoPoint, _ b: GLMapGeoPoint) -> Double {
+        let rad = Double.pi / 180
+        let y = sin((b.lon - a.lon) * rad) * cos(b.lat * rad)
+        let x = cos(a.lat * rad) * sin(b.lat * rad) - sin(a.lat * rad) * cos(b.lat * rad) * cos((b.lon - a.lon) * rad)
+        return atan2(y, x) / rad
+    }
+
+    func testColumnsFromMapPoints() {
+        let columns = GeoPointColumns(mapPoints: targets.map { GLMapPoint(geoPoint: $0) })
+        XCTAssertEqual(columns.count, targets.count)
+        for i in stride(from: 0, to: targets.count, by: 101) {
+            XCTAssertEqual(columns.lats[i], targets[i].lat, accuracy: 1e-9)
+            XCTAssertEqual(columns.lons[i], targets[i].lon, accuracy: 1e-9)
+        }
+    }
+
+    // MARK: Benchmarks, one origin to 100k users
+
+    private lazy var crowd = TestData.geoPoints(100_000, lat: 52...53, lon: 13...14, seed: 3)
+
+    func testScalarDistancePerformance() {
+        let points = crowd
+        measure {
+            var sum = 0.0
+            for p in points {
+                sum += origin.distanceTo(p)
+            }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    func testHaversineBatchPerformance() {
+        let columns = GeoPointColumns(crowd)
+        measure {
+            XCTAssertEqual(GeoBatch.distances(from: origin, to: columns).count, columns.count)
+        }
+    }
+
+    func testEquirectangularBatchPerformance() {
+        let columns = GeoPointColumns(crowd)
+        measure {
+            XCTAssertEqual(GeoBatch.distances(from: origin, to: columns, accuracy: .equirectangular).count, columns.count)
+        }
+    }
+
+    func testScalarBearingPerformance() {
+        let points = crowd
+        measure {
+            var sum = 0.0
+            for p in points {
+                sum += origin.bearingTo(p)
+            }
+            XCTAssertNotEqual(sum, 0)
+        }
+    }
+
+    func testBearingBatchPerformance() {
+        let columns = GeoPointColumns(crowd)
+        measure {
+            XCTAssertEqual(GeoBatch.bearings(from: origin, to: columns).count, columns.count)
+        }
+    }
+}
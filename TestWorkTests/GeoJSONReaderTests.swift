@@ -0,0 +1,266 @@
+//
+//  GeoJSONReaderTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class GeoJSONReaderTests: XCTestCase {
+    private func read(_ json: String) -> GLMapVectorObjectArray? {
+        return GeoJSONReader.objects(from: Data(json.utf8))
+    }
+
+    private func framework(_ data: Data) -> GLMapVectorObjectArray? {
+        return try? GLMapVectorObject.createVectorObjects(fromGeoJSONData: data)
+    }
+
+    private func geometry(_ type: String, _ coordinates: String) -> String {
+        return "{\"type\":\"\(type)\",\"coordinates\":\(coordinates)}"
+    }
+
+    func testRejectsMalformedPositions() {
+        for position in ["[1 2]", "[1,2,]", "[1,2,abc]", "[1,2 3]", "[1]", "[,1,2]", "[1,,2]", "[1,2]]", "[1,2", "[1,2,3,4,5,]", "[1,2,\"3\"]"] {
+            XCTAssertNil(read(geometry("Point", position)), position)
+        }
+        for line in ["[[1,2],]", "[[1,2] [3,4]]", "[[1,2],[3,4]", "[[1,2],[3 4]]", "[[1,2],[3,4,]]"] {
+            XCTAssertNil(read(geometry("LineString", line)), line)
+        }
+    }
+
+    func testAcceptsValidPositions() {
+        let cases: [(String, Double, Double)] = [
+            ("[1,2]", 1, 2), ("[ 1 , 2 ]", 1, 2), ("[13.4,52.5,34.0]", 13.4, 52.5), ("[1,2,3,4,5,6,7]", 1, 2),
+            ("[1e1,-2.5E-1]", 10, -0.25), ("[\n\t13.4,\n\t52.5\n]", 13.4, 52.5), ("[-180,-85.0511287798]", -180, -85.0511287798),
+        ]
+        for (position, lon, lat) in cases {
+            guard let objects = read(geometry("Point", position)), objects.count == 1 else {
+                XCTFail(position)
+                continue
+            }
+            let expected = GLMapPoint(lat: lat, lon: lon)
+            XCTAssertEqual(objects[0].point.x, expected.x, accuracy: 1, position)
+            XCTAssertEqual(objects[0].point.y, expected.y, accuracy: 1, position)
+        }
+    }
+
+    func testRejectsInvalidDocuments() {
+        for json in ["", "   ", "[]", "{", "{\"type\":\"Point\"", "{\"type\":\"Point\",\"coordinates\":[1,2]}x",
+                     "{\"type\":\"Point\",\"coordinates\":[1,2]}{}", "{\"type\":\"Po", "{\"type\":\"Point\" \"coordinates\":[1,2]}",
+                     "{\"type\":\"Point\",\"coordinates\":[1,2],}"] {
+            XCTAssertNil(read(json), json)
+        }
+        XCTAssertEqual(read("  {\"type\":\"Point\",\"coordinates\":[1,2]}\n")?.count, 1)
+    }
+
+    func testGeometryTypes() {
+        let ring = "[[0,0],[0,1],[1,1],[1,0],[0,0]]", hole = "[[0.2,0.2],[0.2,0.4],[0.4,0.4],[0.2,0.2]]"
+        let collection = """
+        {"type":"FeatureCollection","features":[
+          {"type":"Feature","properties":{"name":"a"},"geometry":\(geometry("Point", "[1,2]"))},
+          {"type":"Feature","properties":{"name":"b"},"geometry":\(geometry("MultiPoint", "[[1,2],[3,4],[5,6]]"))},
+          {"type":"Feature","properties":{"name":"c"},"geometry":\(geometry("LineString", "[[1,2],[3,4]]"))},
+          {"type":"Feature","properties":{"name":"d"},"geometry":\(geometry("MultiLineString", "[[[1,2],[3,4]],[[5,6],[7,8],[9,10]]]"))},
+          {"type":"Feature","properties":{"name":"e"},"geometry":\(geometry("Polygon", "[\(ring),\(hole)]"))},
+          {"type":"Feature","properties":{"name":"f"},"geometry":\(geometry("MultiPolygon", "[[\(ring),\(hole)],[\(ring)]]"))},
+          {"type":"Feature","properties":{"name":"g"},"geometry":{"type":"GeometryCollection","geometries":[
+            \(geometry("Point", "[1,2]")),\(geometry("LineString", "[[1,2],[3,4]]"))]}},
+          {"type":"Feature","properties":{"name":"h"},"geometry":null},
+          {"type":"Feature","properties":{"name":"i"},"geometry":\(geometry("LineString", "[]"))}
+        ]}
+        """
+        guard let objects = read(collection) else { return XCTFail() }
+        let kinds = (0..<objects.count).map { i -> String in
+            switch objects[i] {
+            case is GLMapVectorPoint: return "point"
+            case is GLMapVectorLine: return "line"
+            case is GLMapVectorPolygon: return "polygon"
+            default: return "?"
+            }
+        }
+        XCTAssertEqual(kinds, ["point", "point", "point", "point", "line", "line", "polygon", "polygon", "point", "line"])
+        XCTAssertEqual((objects[5] as? GLMapVectorLine)?.lines.map { $0.count }, [2, 3])
+        XCTAssertEqual((objects[6] as? GLMapVectorPolygon)?.buildOutline().lines.count, 2)
+        XCTAssertEqual((objects[7] as? GLMapVectorPolygon)?.buildOutline().lines.count, 3)
+    }
+
+    func testPropertiesAndEscapes() {
+        let json = """
+        {"type":"Feature","geometry":{"type":"Point","coordinates":[1,2]},"properties":{
+          "name":"Zone \\"A\\" \\\\ north","city":"K\\u00f6ln","flag":"\\ud83c\\udde9\\ud83c\\uddea","lone":"x\\ud800y",
+          "brackets":"[1,2] {\\"a\\":3}","height":12.5,"open":true,"empty":null,"nested":{"a":[1,2]}}}
+        """
+        guard let objects = read(json), objects.count == 1 else { return XCTFail() }
+        let geoJSON = objects[0].asGeoJSON()
+        // The serializer escapes on its own terms, so compare through a JSON decoder.
+        guard let decoded = try? JSONSerialization.jsonObject(with: Data(geoJSON.utf8)) as? [String: Any],
+              let properties = decoded["properties"] as? [String: Any] else { return XCTFail(geoJSON) }
+        XCTAssertEqual(properties["name"] as? String, "Zone \"A\" \\ north")
+        XCTAssertEqual(properties["city"] as? String, "Köln")
+        XCTAssertEqual(properties["flag"] as? String, "🇩🇪")
+        XCTAssertEqual(properties["lone"] as? String, "x\u{FFFD}y")
+        XCTAssertEqual(properties["brackets"] as? String, "[1,2] {\"a\":3}")
+        XCTAssertNil(properties["empty"])
+        XCTAssertNotNil(properties["height"])
+        XCTAssertNotNil(properties["nested"])
+    }
+
+    // MARK: Realistic feature collections
+
+    /// Closed star-shaped ring around `center`, radius in degrees.
+    private func ring(_ center: GLMapGeoPoint, radius: Double, count: Int, rng: inout SeededGenerator) -> [GLMapGeoPoint] {
+        var ring = (0..<count).map { k -> GLMapGeoPoint in
+            let a = 2 * Double.pi * Double(k) / Double(count)
+            let r = radius * Double.random(in: 0.6...1, using: &rng)
+            return GLMapGeoPoint(lat: center.lat + r * sin(a), lon: center.lon + r * cos(a) * 1.6)
+        }
+        ring.append(ring[0])
+        return ring
+    }
+
+    private func positions(_ points: [GLMapGeoPoint]) -> String {
+        return "[" + points.map { String(format: "[%.7f,%.7f]", $0.lon, $0.lat) }.joined(separator: ",") + "]"
+    }
+
+    private func collection(_ features: [String]) -> Data {
+        return Data(("{\"type\":\"FeatureCollection\",\"features\":[\n" + features.joined(separator: ",\n") + "\n]}").utf8)
+    }
+
+    /// Geofence zones: polygons with holes and a few multipolygons, with typical string properties.
+    private func zones(_ count: Int, points: Int, seed: UInt64) -> Data {
+        var rng = SeededGenerator(seed: seed)
+        let features = (0..<count).map { k -> String in
+            let center = GLMapGeoPoint(lat: Double.random(in: 48...56, using: &rng), lon: Double.random(in: 5...25, using: &rng))
+            let outer = positions(ring(center, radius: 0.02, count: points, rng: &rng))
+            let hole = positions(ring(center, radius: 0.005, count: points / 4, rng: &rng))
+            let geometry = k % 10 == 0
+                ? "{\"type\":\"MultiPolygon\",\"coordinates\":[[\(outer),\(hole)],[\(positions(ring(GLMapGeoPoint(lat: center.lat + 0.05, lon: center.lon), radius: 0.01, count: points / 2, rng: &rng)))]]}"
+                : "{\"type\":\"Polygon\",\"coordinates\":[\(outer),\(hole)]}"
+            return "{\"type\":\"Feature\",\"properties\":{\"id\":\"zone-\(k)\",\"name\":\"Zone \(k) \\\"Süd\\\"\",\"kind\":\"\(["geofence", "parking", "restricted"][k % 3])\"},\"geometry\":\(geometry)}"
+        }
+        return collection(features)
+    }
+
+    /// Road network: line strings with a few multilines.
+    private func roads(_ count: Int, points: Int, seed: UInt64) -> Data {
+        var rng = SeededGenerator(seed: seed)
+        let features = (0..<count).map { k -> String in
+            let start = GLMapGeoPoint(lat: Double.random(in: 48...56, using: &rng), lon: Double.random(in: 5...25, using: &rng))
+            let walk = TestData.walk(points, from: start, step: 20, seed: seed &+ UInt64(k)).map { GLMapGeoPoint(point: $0) }
+            let geometry = k % 20 == 0
+                ? "{\"type\":\"MultiLineString\",\"coordinates\":[\(positions(Array(walk.prefix(points / 2)))),\(positions(Array(walk.suffix(points / 2))))]}"
+                : "{\"type\":\"LineString\",\"coordinates\":\(positions(walk))}"
+            return "{\"type\":\"Feature\",\"properties\":{\"ref\":\"B\(k % 500)\",\"highway\":\"\(["primary", "secondary", "residential"][k % 3])\"},\"geometry\":\(geometry)}"
+        }
+        return collection(features)
+    }
+
+    /// Points of interest: small geometry, many properties.
+    private func pois(_ count: Int, seed: UInt64) -> Data {
+        var rng = SeededGenerator(seed: seed)
+        let features = (0..<count).map { k -> String in
+            let p = GLMapGeoPoint(lat: Double.random(in: 48...56, using: &rng), lon: Double.random(in: 5...25, using: &rng))
+            return "{\"type\":\"Feature\",\"geometry\":{\"type\":\"Point\",\"coordinates\":[\(String(format: "%.7f,%.7f", p.lon, p.lat))]},"
+                + "\"properties\":{\"id\":\"poi-\(k)\",\"name\":\"Café \(k)\",\"amenity\":\"cafe\",\"opening_hours\":\"Mo-Fr 08:00-18:00\","
+                + "\"addr:street\":\"Hauptstraße\",\"addr:housenumber\":\"\(k % 200)\"}}"
+        }
+        return collection(features)
+    }
+
+    private func assertSameAsFramework(_ data: Data, file: StaticString = #filePath, line: UInt = #line) {
+        guard let ours = GeoJSONReader.objects(from: data), let theirs = framework(data) else {
+            return XCTFail("not parsed", file: file, line: line)
+        }
+        XCTAssertEqual(ours.count, theirs.count, file: file, line: line)
+        for i in 0..<min(ours.count, theirs.count) where ours[i].asGeoJSON() != theirs[i].asGeoJSON() {
+            return XCTFail("object \(i): \(ours[i].asGeoJSON()) != \(theirs[i].asGeoJSON())", file: file, line: line)
+        }
+        let a = ours.bbox, b = theirs.bbox
+        XCTAssertEqual(a.origin.x, b.origin.x, accuracy: 1, file: file, line: line)
+        XCTAssertEqual(a.origin.y, b.origin.y, accuracy: 1, file: file, line: line)
+        XCTAssertEqual(a.size.x, b.size.x, accuracy: 1, file: file, line: line)
+        XCTAssertEqual(a.size.y, b.size.y, accuracy: 1, file: file, line: line)
+    }
+
+    func testMatchesFrameworkParser() {
+        assertSameAsFramework(zones(200, points: 120, seed: 260))
+        assertSameAsFramework(roads(300, points: 60, seed: 261))
+        assertSameAsFramework(pois(1_000, seed: 262))
+    }
+
+    func testPrettyPrintedMatchesCompact() throws {
+        // Re-serialized with sorted keys both times, so only whitespace differs.
+        let object = try JSONSerialization.jsonObject(with: zones(50, points: 40, seed: 263))
+        let compact = try JSONSerialization.data(withJSONObject: object, options: [.sortedKeys])
+        let pretty = try JSONSerialization.data(withJSONObject: object, options: [.sortedKeys, .prettyPrinted])
+        guard let a = GeoJSONReader.objects(from: compact), let b = GeoJSONReader.objects(from: pretty) else { return XCTFail() }
+        XCTAssertEqual(a.count, b.count)
+        for i in 0..<min(a.count, b.count) {
+            XCTAssertEqual(a[i].asGeoJSON(), b[i].asGeoJSON())
+        }
+    }
+
+    // MARK: Benchmarks against createVectorObjectsFromGeoJSONData:
+
+    /// About 60 MB: 5k zones of 400 points with a hole.
+    private lazy var zoneLayer = zones(5_000, points: 400, seed: 264)
+    /// About 50 MB: 20k roads of 100 points.
+    private lazy var roadLayer = roads(20_000, points: 100, seed: 265)
+    /// About 40 MB: 200k points with six properties each.
+    private lazy var poiLayer = pois(200_000, seed: 266)
+
+    func testReadZonesPerformance() {
+        let data = zoneLayer
+        measure {
+            XCTAssertEqual(GeoJSONReader.objects(from: data)?.count, 5_000)
+        }
+    }
+
+    func testFrameworkZonesPerformance() {
+        let data = zoneLayer
+        measure {
+            XCTAssertEqual(framework(data)?.count, 5_000)
+        }
+    }
+
+    func testReadRoadsPerformance() {
+        let data = roadLayer
+        measure {
+            XCTAssertEqual(GeoJSONReader.objects(from: data)?.count, 20_000)
+        }
+    }
+
+    func testFrameworkRoadsPerformance() {
+        let data = roadLayer
+        measure {
+            XCTAssertEqual(framework(data)?.count, 20_000)
+        }
+    }
+
+    func testReadPOIsPerformance() {
+        let data = poiLayer
+        measure {
+            XCTAssertEqual(GeoJSONReader.objects(from: data)?.count, 200_000)
+        }
+    }
+
+    func testFrameworkPOIsPerformance() {
+        let data = poiLayer
+        measure {
+            XCTAssertEqual(framework(data)?.count, 200_000)
+        }
+    }
+
+    /// From a memory-mapped file, the way a layer is loaded at startup.
+    func testReadZonesFromFilePerformance() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("zones-\(UUID().uuidString).geojson")
+        try zoneLayer.write(to: url)
+        defer { try? FileManager.default.removeItem(at: url) }
+        measure {
+            XCTAssertEqual(GeoJSONReader.objects(contentsOf: url)?.count, 5_000)
+        }
+    }
+}
@@ -0,0 +1,132 @@
+//
+//  MapBBoxIndexTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class MapBBoxIndexTests: XCTestCase {
+    private let center = GLMapPoint(lat: 52.52, lon: 13.40)
+
+    private func randomBox(_ rng: inout SeededGenerator, spread: Double = 1_000_000) -> GLMapBBox {
+        // Sizes from labels to districts, so boxes land on many levels.
+        let size = pow(2, Double.random(in: 2...18, using: &rng))
+        let origin = GLMapPoint(x: center.x + Double.random(in: -spread...spread, using: &rng),
+                                y: center.y + Double.random(in: -spread...spread, using: &rng))
+        return GLMapBBox(origin: origin, width: size * Double.random(in: 0.2...1, using: &rng), height: size)
+    }
+
+    private func brute(_ boxes: [MapBBoxIndex.ID: GLMapBBox], _ q: GLMapBBox) -> Set<MapBBoxIndex.ID> {
+        return Set(boxes.filter { $0.value.intersects(bbox: q) }.keys)
+    }
+
+    func testQueriesMatchBruteForce() {
+        var rng = SeededGenerator(seed: 40)
+        let index = MapBBoxIndex()
+        var boxes: [MapBBoxIndex.ID: GLMapBBox] = [:]
+        for step in 0..<6_000 {
+            switch Int.random(in: 0..<10, using: &rng) {
+            case 0..<5:
+                let b = randomBox(&rng)
+                let id = index.insert(b)
+                XCTAssertNil(boxes[id])
+                boxes[id] = b
+            case 5..<7:
+                if let id = boxes.keys.randomElement(using: &rng) {
+                    XCTAssertTrue(index.remove(id))
+                    XCTAssertFalse(index.remove(id))
+                    boxes[id] = nil
+                }
+            default:
+                if let id = boxes.keys.randomElement(using: &rng) {
+                    let b = randomBox(&rng)
+                    index.update(id, to: b)
+                    boxes[id] = b
+                }
+            }
+            if step % 200 == 0 {
+                XCTAssertEqual(index.count, boxes.count)
+                for _ in 0..<20 {
+                    let q = randomBox(&rng)
+                    XCTAssertEqual(Set(index.query(q)), brute(boxes, q))
+                    XCTAssertEqual(index.test(q), !brute(boxes, q).isEmpty)
+                }
+            }
+        }
+        for (id, b) in boxes {
+            XCTAssertTrue(GLMapBBoxEqual(index.bbox(for: id)!, b))
+        }
+    }
+
+    func testEmptyAndDegenerateQueries() {
+        let index = MapBBoxIndex()
+        XCTAssertTrue(index.query(.world).isEmpty)
+        XCTAssertFalse(index.test(.world))
+        var rng = SeededGenerator(seed: 41)
+        for _ in 0..<100 {
+            index.insert(randomBox(&rng))
+        }
+        XCTAssertEqual(index.query(.world).count, 100)
+        XCTAssertTrue(index.query(.empty).isEmpty)
+        XCTAssertTrue(index.query(GLMapBBox(origin: center, width: -10, height: 10)).isEmpty)
+        index.removeAll()
+        XCTAssertEqual(index.count, 0)
+        XCTAssertTrue(index.query(.world).isEmpty)
+    }
+
+    func testRemovedIDsAreReused() {
+        let index = MapBBoxIndex()
+        let box = GLMapBBox(origin: center, width: 10, height: 10)
+        let a = index.insert(box)
+        index.remove(a)
+        XCTAssertNil(index.bbox(for: a))
+        XCTAssertEqual(index.insert(box), a)
+        XCTAssertEqual(index.query(box), [a])
+    }
+
+    // MARK: Benchmarks, 20k boxes
+
+    private func measureMix(queries: Int, updates: Int, churn: Int) {
+        var rng = SeededGenerator(seed: 42)
+        let initial = (0..<20_000).map { _ in randomBox(&rng) }
+        let ops = (0..<20_000).map { _ in (Int.random(in: 0..<(queries + updates + churn), using: &rng), randomBox(&rng)) }
+        measure {
+            let index = MapBBoxIndex()
+            var ids = initial.map { index.insert($0) }
+            var hits = 0
+            for (i, (op, box)) in ops.enumerated() {
+                let slot = i % ids.count
+                if op < queries {
+                    index.query(box) { _ in hits += 1 }
+                } else if op < queries + updates {
+                    index.update(ids[slot], to: box)
+                } else {
+                    index.remove(ids[slot])
+                    ids[slot] = index.insert(box)
+                }
+            }
+            XCTAssertEqual(index.count, initial.count)
+            XCTAssertGreaterThanOrEqual(hits, 0)
+        }
+    }
+
+    func testQueryHeavyMixPerformance() { measureMix(queries: 8, updates: 1, churn: 1) }
+    func testUpdateHeavyMixPerformance() { measureMix(queries: 2, updates: 7, churn: 1) }
+    func testChurnHeavyMixPerformance() { measureMix(queries: 2, updates: 1, churn: 7) }
+
+    func testBulkInsertPerformance() {
+        var rng = SeededGenerator(seed: 43)
+        let boxes = (0..<100_000).map { _ in randomBox(&rng) }
+        measure {
+            let index = MapBBoxIndex()
+            for b in boxes {
+                index.insert(b)
+            }
+            XCTAssertEqual(index.count, boxes.count)
+        }
+    }
+}
@@ -0,0 +1,203 @@
+//
+//  MapMatcherTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class MapMatcherTests: XCTestCase {
+    /// A square street grid: one road per row and column, meeting at shared vertices.
+    private struct City {
+        let origin: GLMapPoint
+        let unit: Double
+        let spacing: Double
+        let blocks: Int
+
+        init(blocks: Int, spacing: Double, at center: GLMapGeoPoint = GLMapGeoPoint(lat: 52.52, lon: 13.40)) {
+            origin = GLMapPoint(geoPoint: center)
+            unit = MapPointIndex.mapUnitsPerMeter(at: origin)
+            self.spacing = spacing
+            self.blocks = blocks
+        }
+
+        func node(_ i: Int, _ j: Int) -> GLMapPoint {
+            return GLMapPoint(x: origin.x + Double(i) * spacing * unit, y: origin.y + Double(j) * spacing * unit)
+        }
+
+        var roads: [[GLMapPoint]] {
+            let rows = (0...blocks).map { j in (0...blocks).map { i in node(i, j) } }
+            let columns = (0...blocks).map { i in (0...blocks).map { j in node(i, j) } }
+            return rows + columns
+        }
+    }
+
+    private struct Drive {
+        /// Intersections passed, in order.
+        var path: [GLMapPoint] = []
+        /// True position at each fix.
+        var truth: [GLMapPoint] = []
+        var fixes: [GLMapGeoPoint] = []
+    }
+
+    /// About 10 m between fixes, mostly straight on, turning at some intersections, with Gaussian GPS noise.
+    private func drive(_ city: City, fixes count: Int, noise: Double = 4, seed: UInt64) -> Drive {
+        var rng = SeededGenerator(seed: seed)
+        let directions = [(1, 0), (0, 1), (-1, 0), (0, -1)]
+        var i = city.blocks / 2, j = city.blocks / 2, direction = 0
+        var drive = Drive()
+        drive.path.append(city.node(i, j))
+        var along = 0.0
+        while drive.truth.count < count {
+            let options = (0..<4).filter { d in
+                d != (direction + 2) % 4 && (0...city.blocks).contains(i + directions[d].0) && (0...city.blocks).contains(j + directions[d].1)
+            }
+            if !options.contains(direction) || Double.random(in: 0..<1, using: &rng) < 0.3 {
+                direction = options.randomElement(using: &rng)!
+            }
+            let a = city.node(i, j)
+            i += directions[direction].0
+            j += directions[direction].1
+            let b = city.node(i, j)
+            while along <= city.spacing && drive.truth.count < count {
+                let f = along / city.spacing
+                drive.truth.append(GLMapPoint(x: a.x + (b.x - a.x) * f, y: a.y + (b.y - a.y) * f))
+                along += Double.random(in: 8...12, using: &rng)
+            }
+            along -= city.spacing
+            drive.path.append(b)
+        }
+        drive.fixes = drive.truth.map { p in
+            let u1 = Double.random(in: Double.ulpOfOne...1, using: &rng), u2 = Double.random(in: 0..<1, using: &rng)
+            let r = (-2 * log(u1)).squareRoot() * noise * city.unit
+            return GLMapGeoPoint(point: GLMapPoint(x: p.x + r * cos(2 * .pi * u2), y: p.y + r * sin(2 * .pi * u2)))
+        }
+        return drive
+    }
+
+    /// Meters from `p` to the polyline.
+    private func distance(_ p: GLMapPoint, to line: [GLMapPoint], unit: Double) -> Double {
+        var best = Double.infinity
+        for (a, b) in zip(line, line.dropFirst()) {
+            let abx = b.x - a.x, aby = b.y - a.y
+            let len2 = abx * abx + aby * aby
+            let t = len2 > 0 ? min(max(((p.x - a.x) * abx + (p.y - a.y) * aby) / len2, 0), 1) : 0
+            best = min(best, hypot(p.x - a.x - t * abx, p.y - a.y - t * aby))
+        }
+        return best / unit
+    }
+
+    private func length(_ line: [GLMapPoint]) -> Double {
+        return zip(line, line.dropFirst()).reduce(0) { $0 + $1.0.distanceTo($1.1) }
+    }
+
+    func testMatchFollowsTheDrivenStreets() {
+        let city = City(blocks: 12, spacing: 150)
+        let matcher = MapMatcher(roads: city.roads)
+        for seed in UInt64(220)..<225 {
+            matcher.reset()
+            let drive = self.drive(city, fixes: 600, seed: seed)
+            for (fix, truth) in zip(drive.fixes, drive.truth) {
+                guard let position = matcher.add(fix) else { return XCTFail("seed \(seed): no match") }
+                XCTAssertLessThan(position.distanceTo(truth), 30, "seed \(seed)")
+            }
+            matcher.finish()
+            XCTAssertEqual(matcher.matchedTraces.count, 1, "seed \(seed)")
+            let trace = matcher.matchedTraces[0]
+            // Never on a parallel street, and about as long as the drive.
+            XCTAssertLessThan(trace.map { distance($0, to: drive.path, unit: city.unit) }.max()!, 15, "seed \(seed)")
+            XCTAssertEqual(length(trace), length(drive.truth), accuracy: length(drive.truth) * 0.05, "seed \(seed)")
+        }
+    }
+
+    func testCommitsIncrementally() {
+        let city = City(blocks: 12, spacing: 150)
+        let matcher = MapMatcher(roads: city.roads)
+        let drive = self.drive(city, fixes: 1_000, seed: 225)
+        for (k, fix) in drive.fixes.enumerated() {
+            matcher.add(fix)
+            guard k % 50 == 49 else { continue }
+            // Only the last few fixes are still open, and the committed part is never rewritten.
+            let committed = matcher.matchedTraces.first ?? []
+            let current = matcher.currentTraces()
+            XCTAssertEqual(current.count, 1)
+            XCTAssertTrue(current[0].starts(with: committed) { $0.x == $1.x && $0.y == $1.y })
+            XCTAssertLessThan(current[0].count - committed.count, 30, "fix \(k)")
+        }
+        XCTAssertEqual(matcher.trackData(color: .black).count, 1)
+    }
+
+    func testUnreachableFixStartsNewTrace() {
+        let a = City(blocks: 6, spacing: 150)
+        let b = City(blocks: 6, spacing: 150, at: GLMapGeoPoint(lat: 52.60, lon: 13.40))
+        let matcher = MapMatcher(roads: a.roads + b.roads)
+        for fix in drive(a, fixes: 100, seed: 226).fixes {
+            XCTAssertNotNil(matcher.add(fix))
+        }
+        // Nothing within the search radius: ignored.
+        XCTAssertNil(matcher.add(GLMapGeoPoint(lat: 52.56, lon: 13.40)))
+        for fix in drive(b, fixes: 100, seed: 227).fixes {
+            XCTAssertNotNil(matcher.add(fix))
+        }
+        XCTAssertEqual(matcher.currentTraces().count, 2)
+        matcher.finish()
+        XCTAssertEqual(matcher.matchedTraces.count, 2)
+        XCTAssertEqual(matcher.trackData(color: .black).count, 2)
+        // Each trace stays in its own city.
+        XCTAssertTrue(matcher.matchedTraces[0].allSatisfy { $0.distanceTo(a.origin) < 1_500 })
+        XCTAssertTrue(matcher.matchedTraces[1].allSatisfy { $0.distanceTo(b.origin) < 1_500 })
+    }
+
+    func testVectorLineRoadsMatchPointRoads() {
+        let city = City(blocks: 8, spacing: 150)
+        let lines = city.roads.map { road in GLMapVectorLine(line: GLMapPointArray(count: UInt(road.count)) { road[Int($0)] }) }
+        let fromPoints = MapMatcher(roads: city.roads)
+        let fromLines = MapMatcher(roads: lines)
+        for fix in drive(city, fixes: 200, seed: 228).fixes {
+            // Vector objects may store vertices on the integer map grid, a centimeter or so apart.
+            guard let p = fromPoints.add(fix), let l = fromLines.add(fix) else { return XCTFail() }
+            XCTAssertLessThan(p.distanceTo(l), 0.1)
+        }
+    }
+
+    // MARK: Benchmarks, a 100 x 100 block city and a drive of about three hours at 1 Hz
+
+    private lazy var bigCity = City(blocks: 100, spacing: 120)
+    private lazy var longDrive = drive(bigCity, fixes: 10_000, seed: 229)
+
+    func testBuildRoadGraphPerformance() {
+        let roads = bigCity.roads
+        measure {
+            XCTAssertNotNil(MapMatcher(roads: roads).add(GLMapGeoPoint(point: roads[0][0])))
+        }
+    }
+
+    func testMatchingThroughputPerformance() {
+        let matcher = MapMatcher(roads: bigCity.roads)
+        let fixes = longDrive.fixes
+        measure {
+            matcher.reset()
+            for fix in fixes {
+                matcher.add(fix)
+            }
+            matcher.finish()
+            XCTAssertEqual(matcher.matchedTraces.count, 1)
+        }
+    }
+
+    func testNoisyMatchingThroughputPerformance() {
+        let matcher = MapMatcher(roads: bigCity.roads)
+        let fixes = drive(bigCity, fixes: 10_000, noise: 12, seed: 230).fixes
+        measure {
+            matcher.reset()
+            for fix in fixes {
+                matcher.add(fix)
+            }
+            matcher.finish()
+            XCTAssertFalse(matcher.matchedTraces.isEmpty)
+        }
+    }
+}
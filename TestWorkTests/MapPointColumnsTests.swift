@@ -0,0 +1,154 @@
+//
+//  MapPointColumnsTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class MapPointColumnsTests: XCTestCase {
+    private func scalarBBox(_ points: [GLMapPoint]) -> GLMapBBox {
+        var bbox = GLMapBBox.empty
+        for p in points {
+            bbox = bbox.adding(p)
+        }
+        return bbox
+    }
+
+    private func scalarLength(_ points: [GLMapPoint]) -> Double {
+        var total = 0.0
+        for i in points.indices.dropFirst() {
+            total += hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y)
+        }
+        return total
+    }
+
+    private func assertEqual(_ a: GLMapBBox, _ b: GLMapBBox, file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertEqual(a.origin.x, b.origin.x, file: file, line: line)
+        XCTAssertEqual(a.origin.y, b.origin.y, file: file, line: line)
+        XCTAssertEqual(a.size.x, b.size.x, accuracy: 1e-6, file: file, line: line)
+        XCTAssertEqual(a.size.y, b.size.y, accuracy: 1e-6, file: file, line: line)
+    }
+
+    func testKernelsMatchScalarOnBothLayouts() {
+        // Odd sizes around the internal chunk of the length kernel.
+        for n in [2, 3, 1023, 1024, 1025, 2049, 10_000] {
+            let points = TestData.walk(n, seed: UInt64(n))
+            let columns = MapPointColumns(points)
+            let bbox = scalarBBox(points), length = scalarLength(points)
+            assertEqual(columns.bbox, bbox)
+            XCTAssertEqual(columns.length, length, accuracy: length * 1e-12)
+            points.withUnsafeBufferPointer {
+                assertEqual(MapPointColumns.bbox(of: $0), bbox)
+                XCTAssertEqual(MapPointColumns.length(of: $0), length, accuracy: length * 1e-12)
+            }
+        }
+    }
+
+    func testEmptyAndSinglePoint() {
+        let empty = MapPointColumns([GLMapPoint]())
+        XCTAssertEqual(empty.count, 0)
+        XCTAssertTrue(GLMapBBoxEqual(empty.bbox, .empty))
+        XCTAssertEqual(empty.length, 0)
+        XCTAssertTrue(empty.interleaved().isEmpty)
+
+        let one = MapPointColumns([GLMapPoint(x: 5, y: 7)])
+        assertEqual(one.bbox, GLMapBBox(origin: GLMapPoint(x: 5, y: 7), width: 0, height: 0))
+        XCTAssertEqual(one.length, 0)
+    }
+
+    func testConversionsRoundTrip() {
+        let points = TestData.mapPoints(4_097, seed: 120)
+        let columns = MapPointColumns(points)
+        XCTAssertEqual(columns.xs.count, points.count)
+        for (i, p) in points.enumerated() {
+            XCTAssertEqual(columns.xs[i], p.x)
+            XCTAssertEqual(columns.ys[i], p.y)
+        }
+        let back = columns.interleaved()
+        XCTAssertTrue(zip(back, points).allSatisfy { $0.x == $1.x && $0.y == $1.y })
+
+        let array = columns.makePointArray()
+        XCTAssertEqual(Int(array.count), points.count)
+        let fromArray = MapPointColumns(array)
+        XCTAssertTrue(zip(fromArray.xs, columns.xs).allSatisfy { $0 == $1 })
+        XCTAssertTrue(zip(fromArray.ys, columns.ys).allSatisfy { $0 == $1 })
+        let fromColumns = MapPointColumns(xs: Array(columns.xs), ys: Array(columns.ys))
+        XCTAssertEqual(fromColumns[4_096].x, points[4_096].x)
+    }
+
+    func testAdoptedColumnsAreNotCopiedAndReleasedOnce() {
+        let n = 100
+        let xs = UnsafeMutablePointer<Double>.allocate(capacity: n)
+        let ys = UnsafeMutablePointer<Double>.allocate(capacity: n)
+        for i in 0..<n {
+            xs[i] = Double(i)
+            ys[i] = Double(2 * i)
+        }
+        var released = 0
+        do {
+            let columns = MapPointColumns(adoptingXs: xs, ys: ys, count: n) { x, y in
+                XCTAssertEqual(x, xs)
+                XCTAssertEqual(y, ys)
+                released += 1
+                x.deallocate()
+                y.deallocate()
+            }
+            XCTAssertEqual(columns.xs.baseAddress, UnsafePointer(xs))
+            XCTAssertEqual(columns.length, 99 * sqrt(5), accuracy: 1e-9)
+            withExtendedLifetime(columns) {
+                XCTAssertEqual(released, 0)
+            }
+        }
+        XCTAssertEqual(released, 1)
+    }
+
+    // MARK: Benchmarks, 1M points: columns vs interleaved vs a plain loop
+
+    private lazy var million = TestData.walk(1_000_000)
+
+    func testBBoxColumnsPerformance() {
+        let columns = MapPointColumns(million)
+        measure {
+            XCTAssertGreaterThan(columns.bbox.size.x, 0)
+        }
+    }
+
+    func testBBoxInterleavedPerformance() {
+        let points = million
+        measure {
+            points.withUnsafeBufferPointer { XCTAssertGreaterThan(MapPointColumns.bbox(of: $0).size.x, 0) }
+        }
+    }
+
+    func testBBoxScalarPerformance() {
+        let points = million
+        measure {
+            XCTAssertGreaterThan(scalarBBox(points).size.x, 0)
+        }
+    }
+
+    func testLengthColumnsPerformance() {
+        let columns = MapPointColumns(million)
+        measure {
+            XCTAssertGreaterThan(columns.length, 0)
+        }
+    }
+
+    func testLengthInterleavedPerformance() {
+        let points = million
+        measure {
+            points.withUnsafeBufferPointer { XCTAssertGreaterThan(MapPointColumns.length(of: $0), 0) }
+        }
+    }
+
+    func testLengthScalarPerformance() {
+        let points = million
+        measure {
+            XCTAssertGreaterThan(scalarLength(points), 0)
+        }
+    }
+}
@@ -0,0 +1,167 @@
+//
+//  MapPointIndexTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class MapPointIndexTests: XCTestCase {
+    private let center = GLMapPoint(lat: 52.52, lon: 13.40)
+    private let spread = 20_000.0
+
+    /// Squared distances of the `k` nearest points, nearest first, by a linear scan.
+    private func bruteNearest(_ points: [GLMapPoint], _ q: GLMapPoint, _ k: Int) -> [Double] {
+        var heap = NeighbourHeap(capacity: k)
+        for (i, p) in points.enumerated() {
+            heap.offer(distanceSquared(p, q), i)
+        }
+        return heap.sorted().map { distanceSquared(points[$0], q) }
+    }
+
+    private func bruteRadius(_ points: [GLMapPoint], _ q: GLMapPoint, _ r: Double) -> Int {
+        return points.filter { distanceSquared($0, q) <= r * r }.count
+    }
+
+    private func assertMatchesBruteForce(_ index: MapPointIndex, _ points: [GLMapPoint], seed: UInt64,
+                                         file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertEqual(index.count, points.count, file: file, line: line)
+        for (i, q) in TestData.mapPoints(50, around: center, spread: spread, seed: seed).enumerated() {
+            let k = 1 + i % 17
+            let found = index.nearest(to: q, k: k).map { distanceSquared($0, q) }
+            XCTAssertEqual(found, bruteNearest(points, q, k), file: file, line: line)
+            let r = spread * Double(1 + i % 5) / 20
+            var n = 0
+            index.forEach(within: r, of: q) { p in
+                XCTAssertLessThanOrEqual(distanceSquared(p, q), r * r, file: file, line: line)
+                n += 1
+            }
+            XCTAssertEqual(n, bruteRadius(points, q, r), file: file, line: line)
+        }
+    }
+
+    func testBulkLoadMatchesBruteForce() {
+        let points = TestData.mapPoints(5_000, around: center, spread: spread)
+        assertMatchesBruteForce(MapPointIndex(points: points), points, seed: 10)
+    }
+
+    func testInsertsMatchBruteForce() {
+        let points = TestData.mapPoints(3_000, around: center, spread: spread)
+        let index = MapPointIndex()
+        for p in points {
+            index.insert(p)
+        }
+        assertMatchesBruteForce(index, points, seed: 11)
+    }
+
+    func testMixedUpdatesMatchBruteForce() {
+        var rng = SeededGenerator(seed: 12)
+        var points = TestData.mapPoints(2_000, around: center, spread: spread)
+        let index = MapPointIndex(points: points)
+        let extra = TestData.mapPoints(4_000, around: center, spread: spread, seed: 13)
+        for (step, p) in extra.enumerated() {
+            if step % 3 == 0, !points.isEmpty {
+                let victim = points.remove(at: Int.random(in: 0..<points.count, using: &rng))
+                XCTAssertTrue(index.remove(victim))
+            } else {
+                index.insert(p)
+                points.append(p)
+            }
+            if step % 1_000 == 999 {
+                assertMatchesBruteForce(index, points, seed: UInt64(step))
+            }
+        }
+        XCTAssertFalse(index.remove(GLMapPoint(x: -1, y: -1)))
+    }
+
+    func testBatchRemoval() {
+        let points = TestData.mapPoints(4_000, around: center, spread: spread)
+        let index = MapPointIndex(points: points)
+        XCTAssertEqual(index.remove(contentsOf: Array(points[0..<100])), 100)
+        XCTAssertEqual(index.remove(contentsOf: Array(points[100..<2_100])), 2_000)
+        XCTAssertEqual(index.remove(contentsOf: Array(points[0..<10])), 0)
+        assertMatchesBruteForce(index, Array(points[2_100...]), seed: 14)
+    }
+
+    func testDuplicatesAndPayloads() {
+        let p = GLMapPoint(x: 100, y: 100)
+        let index = MapPointIndex(items: [.init(point: p, payload: 1), .init(point: p, payload: 2)])
+        index.insert(p, payload: 3)
+        XCTAssertEqual(Set(index.nearestItems(to: p, k: 5).map { $0.payload }), [1, 2, 3])
+        XCTAssertTrue(index.remove(payload: 2, at: p))
+        XCTAssertFalse(index.remove(payload: 2, at: p))
+        XCTAssertEqual(Set(index.nearestItems(to: p, k: 5).map { $0.payload }), [1, 3])
+        XCTAssertFalse(index.insertUnique(p))
+        XCTAssertTrue(index.insertUnique(GLMapPoint(x: 101, y: 100)))
+    }
+
+    func testEmptyIndex() {
+        let index = MapPointIndex()
+        XCTAssertNil(index.nearest(to: center))
+        XCTAssertTrue(index.nearest(to: center, k: 3).isEmpty)
+        XCTAssertTrue(index.points(withinMeters: 500, of: center).isEmpty)
+        XCTAssertFalse(index.contains(center))
+    }
+
+    func testCopyIsIndependent() {
+        let points = TestData.mapPoints(1_000, around: center, spread: spread)
+        let index = MapPointIndex(points: points)
+        let copy = index.copy()
+        copy.insert(center)
+        XCTAssertTrue(copy.remove(points[0]))
+        XCTAssertEqual(index.count, points.count)
+        XCTAssertTrue(index.contains(points[0]))
+        XCTAssertFalse(index.contains(center))
+        assertMatchesBruteForce(index, points, seed: 15)
+    }
+
+    // MARK: Benchmarks, 10 nearest and 500 m radius against a linear scan
+
+    private func measureQueries(_ n: Int, indexed: Bool) {
+        let points = TestData.mapPoints(n, around: center, spread: spread * 5, seed: 20)
+        let queries = TestData.mapPoints(200, around: center, spread: spread * 5, seed: 21)
+        let index = MapPointIndex(points: points)
+        let radius = 500 * MapPointIndex.mapUnitsPerMeter(at: center)
+        measure {
+            var found = 0
+            for q in queries {
+                if indexed {
+                    found += index.nearest(to: q, k: 10).count
+                    index.forEach(within: radius, of: q) { _ in found += 1 }
+                } else {
+                    found += bruteNearest(points, q, 10).count
+                    found += bruteRadius(points, q, radius)
+                }
+            }
+            XCTAssertGreaterThan(found, 0)
+        }
+    }
+
+    func testIndexedQueries10k() { measureQueries(10_000, indexed: true) }
+    func testLinearScan10k() { measureQueries(10_000, indexed: false) }
+    func testIndexedQueries100k() { measureQueries(100_000, indexed: true) }
+    func testLinearScan100k() { measureQueries(100_000, indexed: false) }
+    func testIndexedQueries1M() { measureQueries(1_000_000, indexed: true) }
+    func testLinearScan1M() { measureQueries(1_000_000, indexed: false) }
+
+    func testBulkLoad1MPerformance() {
+        let points = TestData.mapPoints(1_000_000, seed: 22)
+        measure {
+            XCTAssertEqual(MapPointIndex(points: points).count, points.count)
+        }
+    }
+
+    func testInsert100kPerformance() {
+        let points = TestData.mapPoints(100_000, seed: 23)
+        measure {
+            let index = MapPointIndex()
+            for p in points {
+                index.insert(p)
+            }
+            XCTAssertEqual(index.count, points.count)
+        }
+    }
+}
@@ -0,0 +1,187 @@
+//
+//  NumberParserTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class NumberParserTests: XCTestCase {
+    private func parse(_ s: String, separator: Character = ",", capacity: Int = 64) -> (values: [Double], consumed: Int) {
+        var out = [Double](repeating: .nan, count: capacity)
+        let bytes = Array(s.utf8)
+        let (n, consumed) = bytes.withUnsafeBytes { raw in
+            out.withUnsafeMutableBufferPointer { NumberParser.parseDoubles(raw, separator: separator.asciiValue!, into: $0) }
+        }
+        return (Array(out[0..<n]), consumed)
+    }
+
+    /// Numbers in the shapes real feeds use, with random whitespace around separators.
+    private func randomList(_ count: Int, seed: UInt64) -> (text: String, values: [String]) {
+        var rng = SeededGenerator(seed: seed)
+        let spaces = ["", "", "", " ", "\n", " \t", "\r\n  "]
+        var values: [String] = []
+        var text = ""
+        for k in 0..<count {
+            let v = Double.random(in: -1...1, using: &rng) * pow(10, Double(Int.random(in: -8...12, using: &rng)))
+            let s: String
+            switch Int.random(in: 0..<5, using: &rng) {
+            case 0: s = String(format: "%.7f", v)
+            case 1: s = String(format: "%.17g", v)
+            case 2: s = String(format: "%e", v)
+            case 3: s = String(Int(v.rounded(.towardZero)) % 1_000_000)
+            default: s = "\(v)"
+            }
+            values.append(s)
+            text += (k > 0 ? spaces.randomElement(using: &rng)! + "," : "") + spaces.randomElement(using: &rng)! + s
+        }
+        return (text, values)
+    }
+
+    func testValuesMatchStandardLibrary() {
+        for seed in UInt64(240)..<250 {
+            let (text, strings) = randomList(3_000, seed: seed)
+            let parsed = NumberParser.doubles(in: Data(text.utf8))
+            XCTAssertEqual(parsed, strings.map { Double($0)! }, "seed \(seed)")
+
+            var floats = [Float](repeating: .nan, count: strings.count)
+            let bytes = Array(text.utf8)
+            let (n, consumed) = bytes.withUnsafeBytes { raw in
+                floats.withUnsafeMutableBufferPointer { NumberParser.parseFloats(raw, into: $0) }
+            }
+            XCTAssertEqual(n, strings.count)
+            XCTAssertEqual(consumed, bytes.count)
+            XCTAssertEqual(floats, strings.map { Float($0)! }, "seed \(seed)")
+        }
+    }
+
+    func testFullOutputResumesAtNextValue() {
+        let (text, strings) = randomList(1_000, seed: 250)
+        let expected = strings.map { Double($0)! }
+        let bytes = Array(text.utf8)
+        var rng = SeededGenerator(seed: 251)
+        var values: [Double] = []
+        var offset = 0
+        while values.count < expected.count {
+            var out = [Double](repeating: .nan, count: Int.random(in: 1...100, using: &rng))
+            let (n, consumed) = bytes[offset...].withUnsafeBytes { raw in
+                out.withUnsafeMutableBufferPointer { NumberParser.parseDoubles(raw, into: $0) }
+            }
+            XCTAssertGreaterThan(n, 0)
+            values += out[0..<n]
+            offset += consumed
+        }
+        XCTAssertEqual(values, expected)
+        XCTAssertEqual(offset, bytes.count)
+    }
+
+    func testStopsAtTheFirstByteThatIsNotAValue() {
+        XCTAssertEqual(parse("1,2,x,3").values, [1, 2])
+        XCTAssertEqual(parse("1,2,x,3").consumed, 4)
+        XCTAssertEqual(parse("13.4,52.5]],[[").values, [13.4, 52.5])
+        XCTAssertEqual(parse("13.4,52.5]],[[").consumed, 9)
+        XCTAssertEqual(parse("1 2").values, [1])
+        XCTAssertEqual(parse("1 2").consumed, 2)
+        XCTAssertEqual(parse("1,2,").values, [1, 2])
+        XCTAssertEqual(parse("1,2,").consumed, 4)
+        XCTAssertEqual(parse("").values, [])
+        XCTAssertEqual(parse(" , 1").values, [])
+        XCTAssertEqual(parse("nan,1").values, [])
+    }
+
+    func testMalformedValuesStop() {
+        for s in ["1.2.3,4", "--1,4", "1e,4", "1-2,4", "e5,4", ".,4", "1..2,4"] {
+            let (values, consumed) = parse(s)
+            XCTAssertEqual(values, [], s)
+            XCTAssertEqual(consumed, 0, s)
+        }
+        XCTAssertEqual(parse("7,1.2.3").values, [7])
+        XCTAssertEqual(parse("7,1.2.3").consumed, 2)
+    }
+
+    func testOtherSeparators() {
+        XCTAssertEqual(parse("1;2 ; 3;-4e2", separator: ";").values, [1, 2, 3, -400])
+        XCTAssertEqual(parse("1 2\n3\t\t4  5", separator: " ").values, [1, 2, 3, 4, 5])
+        XCTAssertEqual(parse("1\t2\t3", separator: "\t").values, [1, 2, 3])
+    }
+
+    func testValuesAcrossBlockBoundaries() {
+        // Every value end and separator position modulo 64.
+        for pad in 0..<64 {
+            let strings = (0..<40).map { "\($0).\(String(repeating: "5", count: 1 + $0 % 23))" }
+            let values = parse(String(repeating: " ", count: pad) + strings.joined(separator: ",")).values
+            XCTAssertEqual(values, strings.map { Double($0)! }, "pad \(pad)")
+        }
+    }
+
+    // MARK: Benchmarks, 100 MB of lon,lat pairs
+
+    /// "dd.ddddddd,dd.ddddddd," repeated, written digit by digit, which is much faster than formatting 9M values.
+    private lazy var coordinates: [UInt8] = {
+        var rng = SeededGenerator(seed: 252)
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(100_000_000)
+        while bytes.count < 100_000_000 - 32 {
+            if !bytes.isEmpty {
+                bytes.append(UInt8(ascii: ","))
+            }
+            if Bool.random(using: &rng) {
+                bytes.append(UInt8(ascii: "-"))
+            }
+            bytes += String(Int.random(in: 0...179, using: &rng)).utf8
+            bytes.append(UInt8(ascii: "."))
+            for _ in 0..<7 {
+                bytes.append(UInt8(ascii: "0") + UInt8.random(in: 0...9, using: &rng))
+            }
+        }
+        return bytes
+    }()
+
+    private lazy var valueCount = coordinates.reduce(1) { $0 + ($1 == UInt8(ascii: ",") ? 1 : 0) }
+
+    func testParseDoublesPerformance() {
+        let bytes = coordinates
+        var out = [Double](repeating: 0, count: valueCount)
+        measure {
+            let (n, _) = bytes.withUnsafeBytes { raw in
+                out.withUnsafeMutableBufferPointer { NumberParser.parseDoubles(raw, into: $0) }
+            }
+            XCTAssertEqual(n, out.count)
+        }
+    }
+
+    func testParseFloatsPerformance() {
+        let bytes = coordinates
+        var out = [Float](repeating: 0, count: valueCount)
+        measure {
+            let (n, _) = bytes.withUnsafeBytes { raw in
+                out.withUnsafeMutableBufferPointer { NumberParser.parseFloats(raw, into: $0) }
+            }
+            XCTAssertEqual(n, out.count)
+        }
+    }
+
+    /// Baseline: one `ParseDouble` call per value over the rest of the input, then skipping the separator.
+    func testParseDoublePerValuePerformance() {
+        let bytes = coordinates
+        var out = [Double](repeating: 0, count: valueCount)
+        measure {
+            var n = 0
+            bytes.withUnsafeBytes { raw in
+                out.withUnsafeMutableBufferPointer { out in
+                    let base = raw.baseAddress!.assumingMemoryBound(to: CChar.self)
+                    let end = UnsafePointer(base + raw.count)
+                    var p = UnsafePointer(base)
+                    while p < end && n < out.count && ParseDouble(&p, UInt32(end - p), out.baseAddress! + n) {
+                        n += 1
+                        p += 1
+                    }
+                }
+            }
+            XCTAssertEqual(n, out.count)
+        }
+    }
+}
@@ -0,0 +1,96 @@
+//
+//  ScreenBBoxGridTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class ScreenBBoxGridTests: XCTestCase {
+    private let width = 1170.0
+    private let height = 2532.0
+
+    private func randomLabel(_ rng: inout SeededGenerator) -> GLMapBBox {
+        // Labels a little off screen too, they land in the border cells.
+        let origin = GLMapPoint(x: Double.random(in: -100...width, using: &rng),
+                                y: Double.random(in: -100...height, using: &rng))
+        return GLMapBBox(origin: origin,
+                         width: Double.random(in: 20...160, using: &rng),
+                         height: Double.random(in: 12...40, using: &rng))
+    }
+
+    func testNegativeSizeBoxesInOneCell() {
+        let grid = ScreenBBoxGrid(width: width, height: height, cellSize: 32)
+        let box = GLMapBBox(origin: GLMapPoint(x: 10, y: 10), width: 10, height: 10)
+        grid.insert(box)
+        // Both corners of these fall into the cell of `box`.
+        let inverted = [GLMapBBox(origin: GLMapPoint(x: 20, y: 10), width: -5, height: 10),
+                        GLMapBBox(origin: GLMapPoint(x: 10, y: 20), width: 10, height: -5),
+                        GLMapBBox(origin: GLMapPoint(x: 20, y: 20), width: -5, height: -5)]
+        for b in inverted {
+            XCTAssertFalse(box.intersects(bbox: b))
+            XCTAssertFalse(grid.test(b))
+            grid.insert(b)
+        }
+        XCTAssertEqual(grid.count, 1)
+        // Also off screen, where both corners clamp to the same border cell.
+        XCTAssertFalse(grid.test(GLMapBBox(origin: GLMapPoint(x: -10, y: -10), width: -50, height: -50)))
+        XCTAssertFalse(grid.insertIfFree(GLMapBBox(origin: GLMapPoint(x: 5000, y: 5000), width: -1, height: 1)))
+        XCTAssertEqual(grid.count, 1)
+    }
+
+    func testMatchesBruteForce() {
+        var rng = SeededGenerator(seed: 80)
+        let grid = ScreenBBoxGrid(width: width, height: height)
+        for frame in 0..<20 {
+            var placed: [GLMapBBox] = []
+            for _ in 0..<500 {
+                let b = randomLabel(&rng)
+                let collides = placed.contains { $0.intersects(bbox: b) }
+                XCTAssertEqual(grid.test(b), collides, "frame \(frame)")
+                XCTAssertEqual(grid.insertIfFree(b), !collides)
+                if !collides {
+                    placed.append(b)
+                }
+            }
+            XCTAssertEqual(grid.count, placed.count)
+            grid.reset()
+            XCTAssertEqual(grid.count, 0)
+        }
+    }
+
+    func testResetForgetsBoxes() {
+        let grid = ScreenBBoxGrid(width: 64, height: 64, cellSize: 32)
+        let box = GLMapBBox(origin: GLMapPoint(x: 1, y: 1), width: 60, height: 60)
+        grid.insert(box)
+        XCTAssertTrue(grid.test(box))
+        // Enough resets to run through a good part of the generations; each one must start empty.
+        for _ in 0..<10_000 {
+            grid.reset()
+            XCTAssertFalse(grid.test(box))
+            XCTAssertTrue(grid.insertIfFree(box))
+            XCTAssertFalse(grid.insertIfFree(box))
+        }
+    }
+
+    // MARK: Benchmark, 5k labels per frame for one second at 60 fps
+
+    func testLabelPlacementPerformance() {
+        var rng = SeededGenerator(seed: 81)
+        let frames = (0..<60).map { _ in (0..<5_000).map { _ in randomLabel(&rng) } }
+        let grid = ScreenBBoxGrid(width: width, height: height)
+        measure {
+            var placed = 0
+            for labels in frames {
+                grid.reset()
+                for b in labels where grid.insertIfFree(b) {
+                    placed += 1
+                }
+            }
+            XCTAssertGreaterThan(placed, 0)
+        }
+    }
+}
@@ -0,0 +1,207 @@
+//
+//  SimplifierTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class SimplifierTests: XCTestCase {
+    private func distance(_ p: GLMapPoint, toSegment a: GLMapPoint, _ b: GLMapPoint) -> Double {
+        let abx = b.x - a.x, aby = b.y - a.y
+        let len2 = abx * abx + aby * aby
+        var dx = p.x - a.x, dy = p.y - a.y
+        if len2 > 0 {
+            let t = min(max((dx * abx + dy * aby) / len2, 0), 1)
+            dx -= t * abx
+            dy -= t * aby
+        }
+        return (dx * dx + dy * dy).squareRoot()
+    }
+
+    private func triangleArea(_ a: GLMapPoint, _ b: GLMapPoint, _ c: GLMapPoint) -> Double {
+        return abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2
+    }
+
+    func testDouglasPeuckerKeepsPointsWithinTolerance() {
+        let points = TestData.walk(20_000, seed: 160)
+        for tolerance in [10.0, 300.0, 5_000.0] {
+            let kept = Simplifier.indices(points, mode: .douglasPeucker(tolerance: tolerance))
+            XCTAssertEqual(kept.first, 0)
+            XCTAssertEqual(kept.last, points.count - 1)
+            for k in 0..<(kept.count - 1) {
+                for i in (kept[k] + 1)..<kept[k + 1] {
+                    XCTAssertLessThanOrEqual(distance(points[i], toSegment: points[kept[k]], points[kept[k + 1]]), tolerance * (1 + 1e-12))
+                }
+            }
+        }
+    }
+
+    func testVisvalingamBudgetsAreNested() {
+        var rng = SeededGenerator(seed: 161)
+        for round in 0..<40 {
+            let points = TestData.walk(Int.random(in: 3...2_000, using: &rng), step: 20, seed: 1_000 + UInt64(round))
+            var previous = Set(points.indices)
+            for budget in stride(from: points.count, through: 2, by: -max(1, points.count / 7)) {
+                let kept = Simplifier.indices(points, mode: .visvalingamCount(budget))
+                XCTAssertEqual(kept.count, budget)
+                XCTAssertEqual(kept.first, 0)
+                XCTAssertEqual(kept.last, points.count - 1)
+                XCTAssertEqual(kept, kept.sorted())
+                // One removal order, stopped earlier or later.
+                XCTAssertTrue(Set(kept).isSubset(of: previous))
+                previous = Set(kept)
+            }
+        }
+    }
+
+    func testVisvalingamAreaThreshold() {
+        var rng = SeededGenerator(seed: 162)
+        for round in 0..<40 {
+            let points = TestData.walk(Int.random(in: 3...2_000, using: &rng), step: 20, seed: 2_000 + UInt64(round))
+            let minArea = Double.random(in: 1e4...1e8, using: &rng)
+            let kept = Simplifier.indices(points, mode: .visvalingam(minArea: minArea))
+            // Effective areas only grow, so a kept point's own triangle is at least the threshold.
+            for k in 1..<max(1, kept.count - 1) {
+                XCTAssertGreaterThanOrEqual(triangleArea(points[kept[k - 1]], points[kept[k]], points[kept[k + 1]]), minArea)
+            }
+            // The same removal order as a point budget.
+            XCTAssertEqual(kept, Simplifier.indices(points, mode: .visvalingamCount(kept.count)))
+        }
+    }
+
+    func testTrackPointsKeepTheirColors() {
+        let points = TestData.walk(1_000, seed: 168).enumerated().map {
+            GLTrackPoint(pt: $1, color: GLMapColor(red: UInt8($0 % 256), green: 0, blue: 0, alpha: 255))
+        }
+        let indices = Simplifier.indices(points.map { $0.pt }, mode: .visvalingamCount(100))
+        let simplified = Simplifier.simplify(points, mode: .visvalingamCount(100))
+        XCTAssertEqual(simplified.count, 100)
+        for (i, p) in zip(indices, simplified) {
+            XCTAssertEqual(p.color.red, points[i].color.red)
+        }
+    }
+
+    // MARK: Topology
+
+    /// Star-shaped ring: sorted angles with random radii between `minRadius` and `maxRadius`, so it is simple.
+    private func star(_ n: Int, center: GLMapPoint, minRadius: Double, maxRadius: Double, rng: inout SeededGenerator) -> [GLMapPoint] {
+        let angles = (0..<n).map { _ in Double.random(in: 0..<(2 * .pi), using: &rng) }.sorted()
+        return angles.map { a in
+            let r = Double.random(in: minRadius...maxRadius, using: &rng)
+            return GLMapPoint(x: center.x + r * cos(a), y: center.y + r * sin(a))
+        }
+    }
+
+    private func segmentsCross(_ a: GLMapPoint, _ b: GLMapPoint, _ c: GLMapPoint, _ d: GLMapPoint) -> Bool {
+        func orient(_ p: GLMapPoint, _ q: GLMapPoint, _ r: GLMapPoint) -> Double {
+            return (q.x - p.x) * (r.y - p.y) - (q.y - p.y) * (r.x - p.x)
+        }
+        let d1 = orient(c, d, a), d2 = orient(c, d, b), d3 = orient(a, b, c), d4 = orient(a, b, d)
+        return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))
+    }
+
+    /// Whether any two non-adjacent edges of the closed rings cross.
+    private func hasCrossing(_ rings: [[GLMapPoint]]) -> Bool {
+        var edges: [(GLMapPoint, GLMapPoint, Int, Int)] = []
+        for (r, ring) in rings.enumerated() {
+            for i in 0..<ring.count {
+                edges.append((ring[i], ring[(i + 1) % ring.count], r, i))
+            }
+        }
+        for i in 0..<edges.count {
+            for j in (i + 1)..<edges.count {
+                let (a, b, ra, ia) = edges[i], (c, d, rb, ib) = edges[j]
+                let n = rings[ra].count
+                if ra == rb && (abs(ia - ib) == 1 || abs(ia - ib) == n - 1) { continue }
+                if segmentsCross(a, b, c, d) { return true }
+            }
+        }
+        return false
+    }
+
+    func testTopologyIsPreservedForPolygonsWithHoles() {
+        var rng = SeededGenerator(seed: 163)
+        let center = GLMapPoint(x: 1e6, y: 1e6)
+        var unpreservedCrossings = 0
+        for _ in 0..<30 {
+            let outer = star(300, center: center, minRadius: 5_000, maxRadius: 10_000, rng: &rng)
+            let hole = star(200, center: center, minRadius: 3_000, maxRadius: 5_000, rng: &rng)
+            XCTAssertFalse(hasCrossing([outer, hole]))
+            for budget in [10, 40, 120] {
+                let rings = Simplifier.simplifyRings([outer, hole], mode: .visvalingamCount(budget))
+                XCTAssertTrue(rings.allSatisfy { $0.count >= 3 })
+                XCTAssertFalse(hasCrossing(rings), "budget \(budget)")
+                let loose = Simplifier.simplifyRings([outer, hole], mode: .visvalingamCount(budget), preserveTopology: false)
+                if hasCrossing(loose) {
+                    unpreservedCrossings += 1
+                }
+            }
+        }
+        // The rings touch at radius 5000, so without the check simplification does cross them.
+        XCTAssertGreaterThan(unpreservedCrossings, 0)
+    }
+
+    func testClosedRingsKeepTheirClosingPoint() {
+        var rng = SeededGenerator(seed: 164)
+        let ring = star(100, center: GLMapPoint(x: 0, y: 0), minRadius: 50, maxRadius: 100, rng: &rng)
+        for mode in [SimplifyMode.douglasPeucker(tolerance: 20), .visvalingam(minArea: 500), .visvalingamCount(3)] {
+            let closed = Simplifier.simplifyRings([ring + [ring[0]]], mode: mode)[0]
+            XCTAssertTrue(GLMapPointEqual(closed[0], closed[closed.count - 1]))
+            XCTAssertGreaterThanOrEqual(closed.count, 4)
+            let open = Simplifier.simplifyRings([ring], mode: mode)[0]
+            XCTAssertEqual(open.count, closed.count - 1)
+        }
+        let polygon = Simplifier.polygon(outerRings: [ring], mode: .visvalingamCount(20))
+        XCTAssertFalse(GLMapBBoxEqual(polygon.bbox, .empty))
+    }
+
+    // MARK: Benchmarks
+
+    /// A day of 1 Hz city tracking.
+    private lazy var cityTrace = TestData.walk(86_400, step: 8, seed: 165)
+    private lazy var millionTrack = TestData.walk(1_000_000, seed: 166)
+
+    func testDouglasPeuckerCityPerformance() {
+        let points = cityTrace
+        measure {
+            XCTAssertGreaterThan(Simplifier.indices(points, mode: .douglasPeucker(tolerance: 400)).count, 2)
+        }
+    }
+
+    func testVisvalingamCityPerformance() {
+        let points = cityTrace
+        measure {
+            XCTAssertEqual(Simplifier.indices(points, mode: .visvalingamCount(2_000)).count, 2_000)
+        }
+    }
+
+    func testDouglasPeuckerMillionPerformance() {
+        let points = millionTrack
+        measure {
+            XCTAssertGreaterThan(Simplifier.indices(points, mode: .douglasPeucker(tolerance: 400)).count, 2)
+        }
+    }
+
+    func testVisvalingamMillionPerformance() {
+        let points = millionTrack
+        measure {
+            XCTAssertEqual(Simplifier.indices(points, mode: .visvalingamCount(20_000)).count, 20_000)
+        }
+    }
+
+    /// A zone boundary of 100k points with a 20k-point hole, topology preserved.
+    func testTopologyPreservingPolygonPerformance() {
+        var rng = SeededGenerator(seed: 167)
+        let center = GLMapPoint(x: 1e7, y: 1e7)
+        let outer = star(100_000, center: center, minRadius: 50_000, maxRadius: 100_000, rng: &rng)
+        let hole = star(20_000, center: center, minRadius: 10_000, maxRadius: 45_000, rng: &rng)
+        measure {
+            let rings = Simplifier.simplifyRings([outer, hole], mode: .visvalingamCount(5_000))
+            XCTAssertEqual(rings.count, 2)
+        }
+    }
+}
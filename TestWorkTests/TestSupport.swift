@@ -0,0 +1,74 @@
+//
+//  TestSupport.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import Foundation
+import GLMap
+@testable import TestWork
+
+/// SplitMix64, so randomized tests and benchmarks see the same data on every run.
+struct SeededGenerator: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
+
+enum TestData {
+    static func geoPoints(_ count: Int, lat: ClosedRange<Double> = -85...85, lon: ClosedRange<Double> = -180...180,
+                          seed: UInt64 = 1) -> [GLMapGeoPoint] {
+        var rng = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            GLMapGeoPoint(lat: Double.random(in: lat, using: &rng), lon: Double.random(in: lon, using: &rng))
+        }
+    }
+
+    /// Uniform points over the whole world.
+    static func mapPoints(_ count: Int, seed: UInt64 = 1) -> [GLMapPoint] {
+        var rng = SeededGenerator(seed: seed)
+        let max = Double(GLMapPointMax)
+        return (0..<count).map { _ in
+            GLMapPoint(x: Double.random(in: 0..<max, using: &rng), y: Double.random(in: 0..<max, using: &rng))
+        }
+    }
+
+    /// Points scattered around `center`, up to `spread` map units away on each axis.
+    static func mapPoints(_ count: Int, around center: GLMapPoint, spread: Double, seed: UInt64 = 1) -> [GLMapPoint] {
+        var rng = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            GLMapPoint(x: center.x + Double.random(in: -spread...spread, using: &rng),
+                       y: center.y + Double.random(in: -spread...spread, using: &rng))
+        }
+    }
+
+    /// A GPS-like walk: `step` meters per point on average with a slowly turning heading.
+    static func walk(_ count: Int, from start: GLMapGeoPoint = GLMapGeoPoint(lat: 52.52, lon: 13.40), step: Double = 5,
+                     seed: UInt64 = 1) -> [GLMapPoint] {
+        var rng = SeededGenerator(seed: seed)
+        let origin = GLMapPoint(geoPoint: start)
+        let unit = MapPointIndex.mapUnitsPerMeter(at: origin)
+        var p = origin
+        var heading = 0.0
+        var result: [GLMapPoint] = []
+        result.reserveCapacity(count)
+        for _ in 0..<count {
+            result.append(p)
+            heading += Double.random(in: -0.3...0.3, using: &rng)
+            let d = step * unit * Double.random(in: 0.5...1.5, using: &rng)
+            p = GLMapPoint(x: p.x + cos(heading) * d, y: p.y + sin(heading) * d)
+        }
+        return result
+    }
+}
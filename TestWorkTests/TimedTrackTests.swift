@@ -0,0 +1,165 @@
+//
+//  TimedTrackTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TimedTrackTests: XCTestCase {
+    private let color = GLMapColor(red: 0, green: 128, blue: 255, alpha: 255)
+
+    /// About 1 Hz with pauses, and some fixes sharing a timestamp.
+    private func track(_ count: Int, seed: UInt64) -> TimedTrack {
+        var rng = SeededGenerator(seed: seed)
+        var t = 1_790_000_000.0
+        let points = TestData.walk(count, seed: seed).map { GLTrackPoint(pt: $0, color: color) }
+        let times = (0..<count).map { _ -> TimeInterval in
+            switch Int.random(in: 0..<100, using: &rng) {
+            case 0: t += Double.random(in: 60...3_600, using: &rng)
+            case 1...5: break
+            default: t += Double.random(in: 0.5...1.5, using: &rng)
+            }
+            return t
+        }
+        return TimedTrack(points: points, times: times)
+    }
+
+    private func bruteIndex(_ track: TimedTrack, _ time: TimeInterval) -> Int? {
+        return track.times.lastIndex { $0 <= time }
+    }
+
+    func testQueriesMatchLinearScan() {
+        let track = self.track(20_000, seed: 180)
+        var rng = SeededGenerator(seed: 181)
+        let start = track.startTime!, end = track.endTime!
+        for _ in 0..<2_000 {
+            // Mostly inside, sometimes before or after the track, sometimes exactly on a fix.
+            var time = Double.random(in: (start - 100)...(end + 100), using: &rng)
+            if Bool.random(using: &rng) {
+                time = track.times[Int.random(in: 0..<track.count, using: &rng)]
+            }
+            XCTAssertEqual(track.index(at: time), bruteIndex(track, time))
+
+            guard let position = track.position(at: time), let progress = track.progress(at: time) else {
+                return XCTFail()
+            }
+            if time <= start {
+                XCTAssertTrue(GLMapPointEqual(position, track.points[0].pt))
+                XCTAssertEqual(progress, 0)
+            } else if time >= end {
+                XCTAssertTrue(GLMapPointEqual(position, track.points[track.count - 1].pt))
+                XCTAssertEqual(progress, track.distances[track.count - 1])
+            } else {
+                let i = bruteIndex(track, time)!
+                let a = track.points[i].pt, b = track.points[i + 1].pt
+                let span = track.times[i + 1] - track.times[i]
+                let f = span > 0 ? (time - track.times[i]) / span : 0
+                XCTAssertEqual(position.x, a.x + (b.x - a.x) * f, accuracy: 1e-6)
+                XCTAssertEqual(position.y, a.y + (b.y - a.y) * f, accuracy: 1e-6)
+                XCTAssertEqual(progress, track.distances[i] + (track.distances[i + 1] - track.distances[i]) * f, accuracy: 1e-6)
+            }
+        }
+    }
+
+    func testSlicesMatchFilter() {
+        let track = self.track(10_000, seed: 182)
+        var rng = SeededGenerator(seed: 183)
+        for _ in 0..<500 {
+            let a = Double.random(in: (track.startTime! - 50)...(track.endTime! + 50), using: &rng)
+            let b = a + Double.random(in: -10...5_000, using: &rng)
+            let slice = track.slice(from: a, to: b)
+            let expected = track.times.indices.filter { track.times[$0] >= a && track.times[$0] <= b }
+            XCTAssertEqual(Array(slice.range), expected)
+            XCTAssertEqual(slice.isEmpty, expected.isEmpty)
+            if let first = expected.first, let last = expected.last {
+                XCTAssertEqual(slice.length, track.distances[last] - track.distances[first], accuracy: 1e-9)
+                XCTAssertNotNil(slice.makeTrackData())
+                // A view: the slice's indices are the track's.
+                XCTAssertEqual(slice.points.startIndex, first)
+            } else {
+                XCTAssertNil(slice.makeTrackData())
+            }
+        }
+        let interval = DateInterval(start: Date(timeIntervalSince1970: track.times[100]),
+                                    end: Date(timeIntervalSince1970: track.times[200]))
+        XCTAssertEqual(track.slice(interval).range.lowerBound, track.times.firstIndex { $0 >= track.times[100] })
+    }
+
+    func testTimesNeverDecrease() {
+        let track = TimedTrack()
+        XCTAssertNil(track.index(at: 0))
+        XCTAssertNil(track.position(at: 0))
+        for (i, t) in [10.0, 12, 11, 15, 14, 20].enumerated() {
+            track.append(GLTrackPoint(pt: GLMapPoint(x: Double(i) * 100, y: 0), color: color), time: t)
+        }
+        XCTAssertEqual(track.times, [10, 12, 12, 15, 15, 20])
+        XCTAssertEqual(track.index(at: 12), 2)
+        XCTAssertEqual(track.index(at: 9.9), nil)
+        XCTAssertEqual(track.position(at: 17.5)!.x, 450, accuracy: 1e-9)
+    }
+
+    // MARK: Benchmarks, a week at 1 Hz
+
+    private lazy var week = track(7 * 86_400, seed: 184)
+
+    private func queryTimes(_ track: TimedTrack, _ count: Int) -> [TimeInterval] {
+        var rng = SeededGenerator(seed: 185)
+        return (0..<count).map { _ in Double.random(in: track.startTime!...track.endTime!, using: &rng) }
+    }
+
+    func testPositionAtTimePerformance() {
+        let track = week
+        let queries = queryTimes(track, 100_000)
+        measure {
+            var sum = 0.0
+            for t in queries {
+                sum += track.position(at: t)!.x
+            }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    func testProgressAtTimePerformance() {
+        let track = week
+        let queries = queryTimes(track, 100_000)
+        measure {
+            var sum = 0.0
+            for t in queries {
+                sum += track.progress(at: t)!
+            }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    /// Baseline for the two above: a linear scan, on a hundredth of the queries.
+    func testLinearScanPerformance() {
+        let track = week
+        let queries = queryTimes(track, 1_000)
+        measure {
+            var sum = 0
+            for t in queries {
+                sum += bruteIndex(track, t) ?? 0
+            }
+            XCTAssertGreaterThan(sum, 0)
+        }
+    }
+
+    /// One-hour windows, each shown as track data.
+    func testHourSlicesPerformance() {
+        let track = week
+        let queries = queryTimes(track, 1_000)
+        measure {
+            var points = 0
+            for t in queries {
+                let slice = track.slice(from: t, to: t + 3_600)
+                points += slice.range.count
+                _ = slice.makeTrackData()
+            }
+            XCTAssertGreaterThan(points, 0)
+        }
+    }
+}
@@ -0,0 +1,213 @@
+//
+//  TrackFileTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackFileTests: XCTestCase {
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try FileManager.default.removeItem(at: directory)
+    }
+
+    private func url(_ name: String) -> URL {
+        return directory.appendingPathComponent(name)
+    }
+
+    /// A walk whose color changes every few hundred points, like speed-colored history.
+    private func track(_ count: Int, seed: UInt64 = 1) -> [GLTrackPoint] {
+        let palette = [GLMapColor(red: 0, green: 200, blue: 0, alpha: 255), GLMapColor(red: 255, green: 160, blue: 0, alpha: 255),
+                       GLMapColor(red: 220, green: 0, blue: 0, alpha: 255)]
+        return TestData.walk(count, seed: seed).enumerated().map { i, p in
+            GLTrackPoint(pt: p, color: palette[(i / 300 + i / 7_000) % palette.count])
+        }
+    }
+
+    private func times(_ count: Int, seed: UInt64 = 1) -> [Date] {
+        var rng = SeededGenerator(seed: seed)
+        var t = 1_790_000_000.0
+        return (0..<count).map { _ in
+            t += Double.random(in: 0.5...2, using: &rng)
+            return Date(timeIntervalSince1970: t)
+        }
+    }
+
+    private func assertSame(_ decoded: [GLTrackPoint], _ original: ArraySlice<GLTrackPoint>,
+                            file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertEqual(decoded.count, original.count, file: file, line: line)
+        for (d, o) in zip(decoded, original) {
+            let grid = MapPointI(o.pt).mapPoint
+            guard d.pt.x == grid.x, d.pt.y == grid.y, d.color.color == o.color.color else {
+                XCTFail("\(d) != \(o)", file: file, line: line)
+                return
+            }
+        }
+    }
+
+    func testRoundTripWithoutTimestamps() {
+        for count in [1, 2, TrackFile.blockSize - 1, TrackFile.blockSize, TrackFile.blockSize + 1, 10_000] {
+            let points = track(count, seed: UInt64(count))
+            XCTAssertTrue(TrackFile.write(points, to: url("plain.gltk")))
+            guard let reader = TrackFileReader(url: url("plain.gltk")) else {
+                XCTFail("count \(count)")
+                continue
+            }
+            XCTAssertFalse(reader.hasTimestamps)
+            XCTAssertEqual(reader.count, count)
+            XCTAssertEqual(reader.index.count, (count + TrackFile.blockSize - 1) / TrackFile.blockSize)
+            assertSame(reader.allPoints(), points[...])
+            XCTAssertNotNil(reader.makeTrackData())
+        }
+    }
+
+    func testRoundTripWithTimestamps() {
+        let points = track(5_000, seed: 170)
+        let dates = times(5_000, seed: 171)
+        XCTAssertTrue(TrackFile.write(points, timestamps: dates, to: url("timed.gltk")))
+        guard let reader = TrackFileReader(url: url("timed.gltk")), let timed = TimedTrack(reader: reader) else {
+            return XCTFail()
+        }
+        XCTAssertTrue(reader.hasTimestamps)
+        XCTAssertEqual(timed.count, points.count)
+        for (t, d) in zip(timed.times, dates) {
+            XCTAssertEqual(t, d.timeIntervalSince1970, accuracy: 0.0005)
+        }
+        assertSame(timed.points, points[...])
+    }
+
+    func testStreamingWriterMatchesOneShotWrite() throws {
+        let points = track(3_000, seed: 172)
+        XCTAssertTrue(TrackFile.write(points, to: url("a.gltk")))
+        do {
+            let writer = TrackFileWriter(url: url("b.gltk"), timestamps: false)!
+            points.forEach { writer.append($0) }
+            // No explicit finish, deinit writes the index.
+        }
+        XCTAssertEqual(try Data(contentsOf: url("a.gltk")), try Data(contentsOf: url("b.gltk")))
+    }
+
+    func testRandomAccessAndSeeking() {
+        let points = track(20_000, seed: 173)
+        let dates = times(20_000, seed: 174)
+        TrackFile.write(points, timestamps: dates, to: url("seek.gltk"))
+        guard let reader = TrackFileReader(url: url("seek.gltk")) else { return XCTFail() }
+        let all = reader.allPoints()
+        var rng = SeededGenerator(seed: 175)
+        for _ in 0..<200 {
+            let a = Int.random(in: 0..<points.count, using: &rng)
+            let b = Int.random(in: a...min(points.count, a + 3_000), using: &rng)
+            XCTAssertEqual(reader.points(a..<b).map { $0.pt.x }, all[a..<b].map { $0.pt.x })
+
+            let block = reader.block(containingPoint: a)
+            XCTAssertLessThanOrEqual(reader.index[block].firstPoint, a)
+            XCTAssertGreaterThan(block + 1 < reader.index.count ? reader.index[block + 1].firstPoint : reader.count, a)
+            XCTAssertEqual(reader.block(containingTime: dates[a]), block)
+        }
+        var length = 0.0
+        for i in 1..<points.count {
+            length += points[i - 1].pt.distanceTo(points[i].pt)
+            if i % 997 == 0 {
+                let block = reader.block(containingLength: length)
+                XCTAssertLessThanOrEqual(reader.index[block].startLength, length)
+                XCTAssertEqual(block, reader.block(containingPoint: i), "point \(i)")
+            }
+        }
+    }
+
+    func testEmptyTrack() {
+        XCTAssertTrue(TrackFile.write([], to: url("empty.gltk")))
+        let reader = TrackFileReader(url: url("empty.gltk"))
+        XCTAssertEqual(reader?.count, 0)
+        XCTAssertEqual(reader?.allPoints().count, 0)
+        XCTAssertNil(reader?.makeTrackData())
+    }
+
+    func testCorruptFilesAreRejected() throws {
+        TrackFile.write(track(4_000, seed: 176), timestamps: times(4_000), to: url("good.gltk"))
+        let good = try Data(contentsOf: url("good.gltk"))
+        // Truncated anywhere: the footer no longer matches.
+        for cut in [1, 7, 100, good.count / 2, good.count - 5] {
+            try good.prefix(good.count - cut).write(to: url("cut.gltk"))
+            XCTAssertNil(TrackFileReader(url: url("cut.gltk")), "cut \(cut)")
+        }
+        // Garbage inside a block: decoding fails cleanly or yields points, but never traps.
+        var rng = SeededGenerator(seed: 177)
+        for _ in 0..<50 {
+            var bad = good
+            for _ in 0..<8 {
+                let at = Int.random(in: TrackFile.headerSize..<(good.count / 2), using: &rng)
+                bad[at] = UInt8.random(in: 0...255, using: &rng)
+            }
+            try bad.write(to: url("bad.gltk"))
+            guard let reader = TrackFileReader(url: url("bad.gltk")) else { continue }
+            var points: [GLTrackPoint] = []
+            var dates: [Date] = []
+            for b in 0..<reader.index.count {
+                let before = points.count
+                if !reader.decodeBlock(b, into: &points, times: &dates) {
+                    XCTAssertEqual(points.count, before)
+                }
+            }
+        }
+    }
+
+    // MARK: Benchmarks, a 500k-point history track against GeoJSON
+
+    private lazy var history = track(500_000, seed: 178)
+
+    private func geoJSON(_ points: [GLTrackPoint]) -> Data {
+        var s = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{},"
+        s += "\"geometry\":{\"type\":\"LineString\",\"coordinates\":["
+        for (i, p) in points.enumerated() {
+            let g = GLMapGeoPoint(point: p.pt)
+            s += (i > 0 ? ",[" : "[") + String(format: "%.7f,%.7f", g.lon, g.lat) + "]"
+        }
+        s += "]}}]}"
+        return Data(s.utf8)
+    }
+
+    func testSizeAgainstGeoJSON() throws {
+        TrackFile.write(history, to: url("history.gltk"))
+        TrackFile.write(history, timestamps: times(history.count), to: url("timed.gltk"))
+        let binary = try Data(contentsOf: url("history.gltk")).count
+        let timed = try Data(contentsOf: url("timed.gltk")).count
+        let json = geoJSON(history).count
+        print("500k points: GeoJSON \(json) B, track file \(binary) B, with timestamps \(timed) B")
+        XCTAssertLessThan(binary * 8, json)
+    }
+
+    func testLoadTrackFilePerformance() {
+        TrackFile.write(history, to: url("history.gltk"))
+        measure {
+            let data = TrackFileReader(url: url("history.gltk"))?.makeTrackData()
+            XCTAssertNotNil(data)
+        }
+    }
+
+    func testLoadGeoJSONPerformance() throws {
+        try geoJSON(history).write(to: url("history.geojson"))
+        measure {
+            let data = try? Data(contentsOf: url("history.geojson"))
+            let objects = data.flatMap { try? GLMapVectorObject.createVectorObjects(fromGeoJSONData: $0) }
+            XCTAssertEqual(objects?.count, 1)
+        }
+    }
+
+    func testWritePerformance() {
+        let points = history
+        measure {
+            XCTAssertTrue(TrackFile.write(points, to: url("write.gltk")))
+        }
+    }
+}
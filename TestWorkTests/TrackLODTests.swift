@@ -0,0 +1,121 @@
+//
+//  TrackLODTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackLODTests: XCTestCase {
+    private let color = GLMapColor(red: 0, green: 128, blue: 255, alpha: 255)
+
+    private func track(_ count: Int, seed: UInt64 = 1) -> [GLTrackPoint] {
+        return TestData.walk(count, seed: seed).map { GLTrackPoint(pt: $0, color: color) }
+    }
+
+    private func distance(_ p: GLMapPoint, toSegment a: GLMapPoint, _ b: GLMapPoint) -> Double {
+        let abx = b.x - a.x, aby = b.y - a.y
+        let len2 = abx * abx + aby * aby
+        var dx = p.x - a.x, dy = p.y - a.y
+        if len2 > 0 {
+            let t = min(max((dx * abx + dy * aby) / len2, 0), 1)
+            dx -= t * abx
+            dy -= t * aby
+        }
+        return (dx * dx + dy * dy).squareRoot()
+    }
+
+    func testEveryZoomIsADouglasPeuckerSimplification() {
+        let points = track(20_000, seed: 150)
+        let lod = TrackLOD(points: points)
+        let scale = Double(GLMapPointMax) / 256
+        for zoom in 0...TrackLOD.maxZoom {
+            let kept = lod.indices(zoom: zoom)
+            let tolerance = scale / pow(2, Double(zoom))
+            XCTAssertEqual(kept.first, 0)
+            XCTAssertEqual(kept.last, points.count - 1)
+            for k in 0..<(kept.count - 1) {
+                let a = points[kept[k]].pt, b = points[kept[k + 1]].pt
+                for i in (kept[k] + 1)..<kept[k + 1] {
+                    XCTAssertLessThanOrEqual(distance(points[i].pt, toSegment: a, b), tolerance * (1 + 1e-9),
+                                             "zoom \(zoom), point \(i)")
+                }
+            }
+        }
+    }
+
+    func testCoarserZoomsAreSubsets() {
+        let lod = TrackLOD(points: track(50_000, seed: 151))
+        var previous = Set<Int>()
+        for zoom in 0...TrackLOD.maxZoom {
+            let kept = lod.indices(zoom: zoom)
+            XCTAssertEqual(kept.count, lod.count(zoom: zoom))
+            XCTAssertEqual(lod.points(zoom: zoom).count, kept.count)
+            let set = Set(kept)
+            XCTAssertTrue(previous.isSubset(of: set), "zoom \(zoom)")
+            previous = set
+        }
+        // Out-of-range zooms clamp.
+        XCTAssertEqual(lod.indices(zoom: -3), lod.indices(zoom: 0))
+        XCTAssertEqual(lod.indices(zoom: 40), lod.indices(zoom: TrackLOD.maxZoom))
+    }
+
+    func testParallelBuildMatchesSerial() {
+        let points = track(200_000, seed: 152)
+        XCTAssertEqual(TrackLOD(points: points, parallel: true).minZoom, TrackLOD(points: points, parallel: false).minZoom)
+    }
+
+    func testDegenerateTracks() {
+        XCTAssertNil(TrackLOD(points: []).trackData(zoomLevel: 10))
+        let one = TrackLOD(points: track(1))
+        XCTAssertEqual(one.minZoom, [0])
+        let p = GLTrackPoint(pt: GLMapPoint(x: 100, y: 100), color: color)
+        let same = TrackLOD(points: [p, p, p, p])
+        XCTAssertEqual(same.minZoom, [0, TrackLOD.never, TrackLOD.never, 0])
+        XCTAssertNotNil(same.trackData(zoomLevel: 3.2))
+    }
+
+    // MARK: Benchmarks, 1M points
+
+    private lazy var million = track(1_000_000, seed: 153)
+
+    func testBuildSerialPerformance() {
+        let points = million
+        measure {
+            XCTAssertEqual(TrackLOD(points: points, parallel: false).minZoom.count, points.count)
+        }
+    }
+
+    func testBuildParallelPerformance() {
+        let points = million
+        measure {
+            XCTAssertEqual(TrackLOD(points: points, parallel: true).minZoom.count, points.count)
+        }
+    }
+
+    /// Zoom change latency: a linear filter plus track data for the kept points, for each zoom from 10 to 20.
+    func testZoomChangePerformance() {
+        let lod = TrackLOD(points: million)
+        measure {
+            for zoom in 10...20 {
+                let selected = lod.points(zoom: zoom)
+                let data = selected.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }
+                XCTAssertNotNil(data)
+            }
+        }
+    }
+
+    /// Baseline: handing all points to the framework, which simplifies them again for every zoom.
+    func testZoomChangeFullTrackPerformance() {
+        let points = million
+        measure {
+            for _ in 10...20 {
+                let data = points.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }
+                XCTAssertNotNil(data)
+            }
+        }
+    }
+}
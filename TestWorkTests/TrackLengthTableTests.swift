@@ -0,0 +1,146 @@
+//
+//  TrackLengthTableTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackLengthTableTests: XCTestCase {
+    /// Per-location reference built on `locate`, one binary search each.
+    private func scalarSample(_ table: TrackLengthTable, _ location: Double) -> GLTrackSampleResult {
+        let (s, f) = table.locate(min(max(location, 0), table.length))
+        let a = table.points[s], b = table.points[s + 1]
+        let dx = b.x - a.x, dy = b.y - a.y
+        let len = hypot(dx, dy)
+        return GLTrackSampleResult(position: GLMapPoint(x: a.x + dx * f, y: a.y + dy * f),
+                                   direction: GLMapPoint(x: len > 0 ? dx / len : 0, y: len > 0 ? dy / len : 0))
+    }
+
+    private func assertClose(_ a: GLTrackSampleResult, _ b: GLTrackSampleResult, file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertEqual(a.position.x, b.position.x, accuracy: 1e-6, file: file, line: line)
+        XCTAssertEqual(a.position.y, b.position.y, accuracy: 1e-6, file: file, line: line)
+        XCTAssertEqual(a.direction.x, b.direction.x, accuracy: 1e-9, file: file, line: line)
+        XCTAssertEqual(a.direction.y, b.direction.y, accuracy: 1e-9, file: file, line: line)
+    }
+
+    /// A walk with a few repeated points, so some segments have zero length.
+    private func track(_ count: Int, seed: UInt64) -> [GLMapPoint] {
+        var points = TestData.walk(count, seed: seed)
+        for i in stride(from: 10, to: count, by: 977) {
+            points[i] = points[i - 1]
+        }
+        return points
+    }
+
+    func testPrefixIsCumulativeLength() {
+        let points = track(10_000, seed: 200)
+        let table = TrackLengthTable(points: points)
+        var length = 0.0
+        for i in 1..<points.count {
+            length += points[i - 1].distanceTo(points[i])
+            XCTAssertEqual(table.prefix[i], length, accuracy: length * 1e-12)
+        }
+        XCTAssertEqual(table.prefix[0], 0)
+        XCTAssertEqual(table.length, length, accuracy: length * 1e-12)
+    }
+
+    func testBatchSamplingMatchesScalar() {
+        let table = TrackLengthTable(points: track(20_000, seed: 201))
+        var rng = SeededGenerator(seed: 202)
+        // Unsorted, with duplicates, exact vertices and locations off both ends.
+        var locations = (0..<5_000).map { _ in Double.random(in: -100...(table.length + 100), using: &rng) }
+        locations += Array(table.prefix[0..<50]) + [0, table.length, locations[7], locations[7]]
+        let batch = table.sample(locations)
+        XCTAssertEqual(batch.count, locations.count)
+        for (location, result) in zip(locations, batch) {
+            assertClose(result, scalarSample(table, location))
+        }
+        let sorted = table.sample(locations.sorted())
+        for (location, result) in zip(locations.sorted(), sorted) {
+            assertClose(result, scalarSample(table, location))
+        }
+    }
+
+    func testEvenSpacing() {
+        let table = TrackLengthTable(points: track(3_000, seed: 203))
+        let samples = table.sample(every: 250, offset: 40)
+        XCTAssertEqual(samples.count, Int(((table.length - 40) / 250).rounded(.down)) + 1)
+        for (k, result) in samples.enumerated() {
+            assertClose(result, scalarSample(table, 40 + 250 * Double(k)))
+        }
+        XCTAssertTrue(table.sample(every: 0).isEmpty)
+        XCTAssertTrue(table.sample(every: 10, offset: table.length + 1).isEmpty)
+    }
+
+    func testDegenerateTables() {
+        let empty = TrackLengthTable(points: [])
+        XCTAssertEqual(empty.length, 0)
+        XCTAssertEqual(empty.sample([1, 2]).count, 2)
+        let one = TrackLengthTable(points: [GLMapPoint(x: 7, y: 9)])
+        XCTAssertEqual(one.sample([5]).first?.position.x, 7)
+        XCTAssertTrue(one.sample([]).isEmpty)
+    }
+
+    // MARK: Benchmarks, 10k locations on a 1M-point track
+
+    private lazy var million = TestData.walk(1_000_000, seed: 204)
+
+    private func locations(_ length: Double) -> [Double] {
+        var rng = SeededGenerator(seed: 205)
+        return (0..<10_000).map { _ in Double.random(in: 0...length, using: &rng) }
+    }
+
+    func testBuildTablePerformance() {
+        let points = million
+        measure {
+            XCTAssertGreaterThan(TrackLengthTable(points: points).length, 0)
+        }
+    }
+
+    func testBatchSamplePerformance() {
+        let table = TrackLengthTable(points: million)
+        let locations = self.locations(table.length)
+        _ = table.sample([0])
+        measure {
+            XCTAssertEqual(table.sample(locations).count, locations.count)
+        }
+    }
+
+    func testBatchSampleSortedPerformance() {
+        let table = TrackLengthTable(points: million)
+        let locations = self.locations(table.length).sorted()
+        _ = table.sample([0])
+        measure {
+            XCTAssertEqual(table.sample(locations).count, locations.count)
+        }
+    }
+
+    /// Baseline: one binary search per location.
+    func testScalarSamplePerformance() {
+        let table = TrackLengthTable(points: million)
+        let locations = self.locations(table.length)
+        measure {
+            var x = 0.0
+            for l in locations {
+                x += scalarSample(table, l).position.x
+            }
+            XCTAssertGreaterThan(x, 0)
+        }
+    }
+
+    /// Baseline: the framework's sampling on the same track and locations.
+    func testFrameworkSamplePerformance() {
+        let track = million.map { GLTrackPoint(pt: $0, color: .black) }
+        let data = track.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }!
+        let locations = self.locations(TrackLengthTable(points: million).length)
+        var result = [GLTrackSampleResult](repeating: GLTrackSampleResult(), count: locations.count)
+        measure {
+            let n = data.sample(locations, count: UInt32(locations.count), result: &result)
+            XCTAssertLessThanOrEqual(n, UInt32(locations.count))
+        }
+    }
+}
@@ -0,0 +1,140 @@
+//
+//  TrackRecorderTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackRecorderTests: XCTestCase {
+    private let color = GLMapColor(red: 0, green: 128, blue: 255, alpha: 255)
+
+    private func record(_ points: [GLMapPoint]) -> TrackRecorder {
+        let recorder = TrackRecorder()
+        recorder.append(contentsOf: points.map { GLTrackPoint(pt: $0, color: color) })
+        return recorder
+    }
+
+    /// A walk that now and then turns back on itself, the hard case for the sleeve.
+    private func trace(_ count: Int, seed: UInt64) -> [GLMapPoint] {
+        var points = TestData.walk(count, seed: seed)
+        var rng = SeededGenerator(seed: seed &+ 1)
+        var i = 100
+        while i + 50 < count {
+            let back = Int.random(in: 5...50, using: &rng)
+            let pivot = points[i]
+            for k in 1...back {
+                points[i + k] = GLMapPoint(x: 2 * pivot.x - points[i + k].x, y: 2 * pivot.y - points[i + k].y)
+            }
+            i += Int.random(in: 200...2_000, using: &rng)
+        }
+        return points
+    }
+
+    private func distance(_ p: GLMapPoint, toLineThrough a: GLMapPoint, _ b: GLMapPoint) -> Double {
+        let dx = b.x - a.x, dy = b.y - a.y
+        return abs((p.x - a.x) * dy - (p.y - a.y) * dx) / (dx * dx + dy * dy).squareRoot()
+    }
+
+    func testDroppedPointsStayWithinTolerance() {
+        let points = trace(30_000, seed: 140)
+        let recorder = record(points)
+        var previousCount = Int.max
+        for level in 0..<recorder.levelCount {
+            let kept = recorder.indices(level: level)
+            let tolerance = recorder.baseTolerance * Double(1 << level)
+            XCTAssertEqual(kept.first, 0)
+            XCTAssertEqual(kept.last, points.count - 1)
+            XCTAssertLessThanOrEqual(kept.count, previousCount)
+            previousCount = kept.count
+            // The stretch after the last kept point is still open, so it is not checked.
+            for k in 0..<max(0, kept.count - 2) {
+                let a = points[kept[k]], b = points[kept[k + 1]]
+                for i in (kept[k] + 1)..<kept[k + 1] {
+                    XCTAssertLessThanOrEqual(distance(points[i], toLineThrough: a, b), tolerance * (1 + 1e-9),
+                                             "level \(level), point \(i)")
+                }
+            }
+        }
+    }
+
+    func testChunksCoverTheSimplifiedTrack() {
+        let recorder = record(trace(100_000, seed: 141))
+        for zoom in [12.0, 15.0, 18.0, 20.0] {
+            let tolerance = TrackRecorder.tolerance(pixels: 1, zoomLevel: zoom)
+            let simplified = recorder.points(level: recorder.level(for: tolerance))
+            let chunks = recorder.trackChunks(tolerance: tolerance)
+            let runs = Double(simplified.count) / Double(TrackRecorder.chunkSize)
+            XCTAssertLessThanOrEqual(Double(chunks.count), log2(max(runs, 1)) + 2, "zoom \(zoom)")
+
+            var expected = GLMapBBox.empty
+            simplified.forEach { expected = expected.adding($0.pt) }
+            var covered = GLMapBBox.empty
+            for chunk in chunks {
+                let b = chunk.bbox()
+                covered = covered.adding(b.origin).adding(GLMapPoint(x: b.origin.x + b.size.x, y: b.origin.y + b.size.y))
+            }
+            XCTAssertEqual(covered.origin.x, expected.origin.x, accuracy: 1e-6)
+            XCTAssertEqual(covered.origin.y, expected.origin.y, accuracy: 1e-6)
+            XCTAssertEqual(covered.size.x, expected.size.x, accuracy: 1e-6)
+            XCTAssertEqual(covered.size.y, expected.size.y, accuracy: 1e-6)
+        }
+    }
+
+    func testOnlyTailIsRebuiltOnAppend() {
+        let points = trace(40_000, seed: 142)
+        let recorder = TrackRecorder()
+        let tolerance = TrackRecorder.tolerance(pixels: 1, zoomLevel: 19)
+        var previous: [GLMapTrackData] = []
+        var merges = 0
+        for p in points {
+            recorder.append(p, color: color)
+            let chunks = recorder.trackChunks(tolerance: tolerance)
+            let fresh = chunks.filter { c in !previous.contains { $0 === c } }
+            // The tail, plus at most one sealed run that was just merged.
+            XCTAssertLessThanOrEqual(fresh.count, 2)
+            if fresh.count == 2 {
+                merges += 1
+            }
+            previous = chunks
+            // Asking again without an append rebuilds nothing.
+            let again = recorder.trackChunks(tolerance: tolerance)
+            XCTAssertEqual(again.count, chunks.count)
+            XCTAssertTrue(zip(again, chunks).allSatisfy { $0 === $1 })
+        }
+        XCTAssertGreaterThan(merges, 0)
+    }
+
+    func testRemoveAll() {
+        let recorder = record(trace(5_000, seed: 143))
+        XCTAssertFalse(recorder.trackChunks(tolerance: recorder.baseTolerance).isEmpty)
+        recorder.removeAll()
+        XCTAssertEqual(recorder.count, 0)
+        XCTAssertTrue(recorder.indices(level: 0).isEmpty)
+        XCTAssertTrue(recorder.trackChunks(tolerance: recorder.baseTolerance).isEmpty)
+        recorder.append(GLMapPoint(x: 10, y: 10), color: color)
+        XCTAssertEqual(recorder.indices(level: 3), [0])
+        XCTAssertLessThanOrEqual(recorder.trackChunks(tolerance: recorder.baseTolerance).count, 1)
+    }
+
+    // MARK: Benchmark, a 1M-point track recorded at 10 Hz
+
+    /// Every fix is appended and the shown track refreshed, as the map would do on each location update.
+    /// 1M fixes at 10 Hz is about 28 hours of recording.
+    func testRecordMillionPointsAt10HzPerformance() {
+        let points = trace(1_000_000, seed: 144)
+        let tolerance = TrackRecorder.tolerance(pixels: 1, zoomLevel: 17)
+        measure {
+            let recorder = TrackRecorder()
+            var shown = 0
+            for p in points {
+                recorder.append(p, color: color)
+                shown = recorder.trackChunks(tolerance: tolerance).count
+            }
+            XCTAssertGreaterThan(shown, 0)
+        }
+    }
+}
@@ -0,0 +1,143 @@
+//
+//  TrackSegmentIndexTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackSegmentIndexTests: XCTestCase {
+    private func bruteNearest(_ points: [GLMapPoint], _ p: GLMapPoint) -> (distance: Double, segment: Int) {
+        var best = (distance: Double.infinity, segment: -1)
+        for s in 0..<(points.count - 1) {
+            let a = points[s], b = points[s + 1]
+            let abx = b.x - a.x, aby = b.y - a.y
+            let len2 = abx * abx + aby * aby
+            let t = len2 > 0 ? min(max(((p.x - a.x) * abx + (p.y - a.y) * aby) / len2, 0), 1) : 0
+            let d = hypot(p.x - a.x - t * abx, p.y - a.y - t * aby)
+            if d < best.distance {
+                best = (d, s)
+            }
+        }
+        return best
+    }
+
+    /// Live fixes along the route: each point nudged by up to `noise` map units.
+    private func fixes(along points: [GLMapPoint], every step: Int, noise: Double, seed: UInt64) -> [GLMapPoint] {
+        var rng = SeededGenerator(seed: seed)
+        return stride(from: 0, to: points.count, by: step).map { i in
+            GLMapPoint(x: points[i].x + Double.random(in: -noise...noise, using: &rng),
+                       y: points[i].y + Double.random(in: -noise...noise, using: &rng))
+        }
+    }
+
+    func testNearestMatchesBruteForce() {
+        let points = TestData.walk(20_000, seed: 190)
+        let index = TrackSegmentIndex(points: points)
+        let bbox = MapPointColumns(points).bbox
+        let queries = TestData.mapPoints(2_000, around: bbox.center, spread: max(bbox.size.x, bbox.size.y), seed: 191)
+        let prefix = TrackLengthTable(points: points).prefix
+        for q in queries {
+            let expected = bruteNearest(points, q)
+            guard let snap = index.nearest(to: q) else { return XCTFail() }
+            XCTAssertEqual(snap.distance, expected.distance, accuracy: expected.distance * 1e-9 + 1e-9)
+            XCTAssertEqual(hypot(snap.point.x - q.x, snap.point.y - q.y), snap.distance, accuracy: snap.distance * 1e-9 + 1e-6)
+            XCTAssertTrue((0...1).contains(snap.fraction))
+            XCTAssertGreaterThanOrEqual(snap.progress, prefix[snap.segment] - 1e-9)
+            XCTAssertLessThanOrEqual(snap.progress, prefix[snap.segment + 1] + 1e-9)
+        }
+    }
+
+    func testMaxDistance() {
+        let points = TestData.walk(5_000, seed: 192)
+        let index = TrackSegmentIndex(points: points)
+        var rng = SeededGenerator(seed: 193)
+        for q in TestData.mapPoints(500, around: points[2_500], spread: 50_000, seed: 194) {
+            let expected = bruteNearest(points, q).distance
+            let limit = expected * Double.random(in: 0.5...1.5, using: &rng)
+            let snap = index.nearest(to: q, maxDistance: limit)
+            XCTAssertEqual(snap == nil, expected > limit, "\(expected) vs \(limit)")
+        }
+    }
+
+    func testHintedSearchAgreesWithUnhinted() {
+        let points = TestData.walk(50_000, seed: 195)
+        let index = TrackSegmentIndex(points: points)
+        var hint: TrackSnap?
+        // Following the route, then jumping to random far points, where the hint is useless.
+        let live = fixes(along: points, every: 7, noise: 400, seed: 196) + TestData.mapPoints(200, around: points[0], spread: 1e6, seed: 197)
+        for q in live {
+            let hinted = index.nearest(to: q, hint: hint)
+            let plain = index.nearest(to: q)
+            XCTAssertEqual(hinted!.distance, plain!.distance, accuracy: 1e-9)
+            hint = hinted
+        }
+    }
+
+    func testDegenerateTracks() {
+        XCTAssertNil(TrackSegmentIndex(points: []).nearest(to: GLMapPoint(x: 0, y: 0)))
+        XCTAssertNil(TrackSegmentIndex(points: [GLMapPoint(x: 5, y: 5)]).nearest(to: GLMapPoint(x: 0, y: 0)))
+        let same = TrackSegmentIndex(points: [GLMapPoint(x: 5, y: 5), GLMapPoint(x: 5, y: 5)])
+        XCTAssertEqual(same.nearest(to: GLMapPoint(x: 8, y: 9))?.distance ?? 0, 5, accuracy: 1e-12)
+        let line = TrackSegmentIndex(points: [GLMapPoint(x: 0, y: 0), GLMapPoint(x: 10, y: 0)])
+        let snap = line.nearest(to: GLMapPoint(x: 4, y: 3))
+        XCTAssertEqual(snap?.fraction ?? -1, 0.4, accuracy: 1e-12)
+        XCTAssertEqual(snap?.distance ?? -1, 3, accuracy: 1e-12)
+    }
+
+    // MARK: Benchmarks, live updates on a 200k-point route
+
+    private lazy var route = TestData.walk(200_000, seed: 198)
+    private lazy var updates = fixes(along: route, every: 20, noise: 300, seed: 199)
+
+    func testBuildPerformance() {
+        let points = route
+        measure {
+            XCTAssertNotNil(TrackSegmentIndex(points: points).nearest(to: points[0]))
+        }
+    }
+
+    func testHintedUpdatePerformance() {
+        let index = TrackSegmentIndex(points: route)
+        let updates = self.updates
+        _ = index.nearest(to: updates[0])
+        measure {
+            var hint: TrackSnap?
+            for q in updates {
+                hint = index.nearest(to: q, hint: hint)
+            }
+            XCTAssertNotNil(hint)
+        }
+    }
+
+    func testUnhintedUpdatePerformance() {
+        let index = TrackSegmentIndex(points: route)
+        let updates = self.updates
+        _ = index.nearest(to: updates[0])
+        measure {
+            var progress = 0.0
+            for q in updates {
+                progress += index.nearest(to: q)!.progress
+            }
+            XCTAssertGreaterThan(progress, 0)
+        }
+    }
+
+    /// Baseline: the framework's scan over the track, on a tenth of the updates.
+    func testFindProgressByPointPerformance() {
+        let track = route.map { GLTrackPoint(pt: $0, color: .black) }
+        let data = track.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }!
+        let updates = self.updates.enumerated().filter { $0.offset % 10 == 0 }.map { $0.element }
+        measure {
+            var progress = 0.0
+            for q in updates {
+                var nearest = GLMapPoint()
+                progress += data.findProgress(by: q, nearestPoint: &nearest)
+            }
+            XCTAssertGreaterThanOrEqual(progress, 0)
+        }
+    }
+}
@@ -0,0 +1,165 @@
+//
+//  TrackSegmentMergerTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackSegmentMergerTests: XCTestCase {
+    private let color = GLMapColor(red: 0, green: 128, blue: 255, alpha: 255)
+
+    /// `trips` walks chopped into segments of `length` points that share their joints, shuffled like a
+    /// day of recording read back from storage.
+    private func segments(trips: Int, perTrip: Int, length: Int, closed: Bool = false, seed: UInt64) -> [[GLTrackPoint]] {
+        var rng = SeededGenerator(seed: seed)
+        var result: [[GLTrackPoint]] = []
+        for t in 0..<trips {
+            var points = TestData.walk(perTrip * (length - 1) + 1, from: GLMapGeoPoint(lat: 52.52 + Double(t) * 0.01, lon: 13.40),
+                                       seed: seed &+ UInt64(t))
+            if closed {
+                points[points.count - 1] = points[0]
+            }
+            for s in 0..<perTrip {
+                result.append(points[(s * (length - 1))...((s + 1) * (length - 1))].map { GLTrackPoint(pt: $0, color: color) })
+            }
+        }
+        result.shuffle(using: &rng)
+        return result
+    }
+
+    private func same(_ a: GLMapPoint, _ b: GLMapPoint) -> Bool {
+        return a.x == b.x && a.y == b.y
+    }
+
+    /// Every segment in exactly one chain, each link joining an end to the next start.
+    private func assertValid(_ chains: [[Int]], _ segments: [[GLTrackPoint]], file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertEqual(chains.flatMap { $0 }.sorted(), Array(segments.indices), file: file, line: line)
+        for chain in chains {
+            for (a, b) in zip(chain, chain.dropFirst()) where !same(segments[a].last!.pt, segments[b].first!.pt) {
+                return XCTFail("\(a) -> \(b) is not a joint", file: file, line: line)
+            }
+        }
+    }
+
+    func testShuffledTripsMergeBack() {
+        let segments = self.segments(trips: 20, perTrip: 150, length: 30, seed: 210)
+        for parallel in [false, true] {
+            let chains = TrackSegmentMerger.chains(segments, parallel: parallel)
+            XCTAssertEqual(chains.count, 20)
+            assertValid(chains, segments)
+        }
+        // Each run is one trip, with every joint point once.
+        let runs = TrackSegmentMerger.merge(segments)
+        XCTAssertEqual(runs.map { $0.count }, Array(repeating: 150 * 29 + 1, count: 20))
+        var trips = (0..<20).map { t in
+            TestData.walk(150 * 29 + 1, from: GLMapGeoPoint(lat: 52.52 + Double(t) * 0.01, lon: 13.40), seed: 210 &+ UInt64(t))
+        }
+        for run in runs {
+            guard let t = trips.firstIndex(where: { same($0[0], run[0].pt) }) else { return XCTFail() }
+            XCTAssertTrue(zip(trips[t], run).allSatisfy { same($0, $1.pt) })
+            trips.remove(at: t)
+        }
+    }
+
+    func testClosedLoops() {
+        let segments = self.segments(trips: 5, perTrip: 40, length: 10, closed: true, seed: 211)
+        let chains = TrackSegmentMerger.chains(segments)
+        XCTAssertEqual(chains.count, 5)
+        assertValid(chains, segments)
+        // A loop starts from its lowest segment and closes on itself.
+        for chain in chains {
+            XCTAssertEqual(chain[0], chain.min())
+            XCTAssertTrue(same(segments[chain.last!].last!.pt, segments[chain[0]].first!.pt))
+        }
+        for run in TrackSegmentMerger.merge(segments) {
+            XCTAssertEqual(run.count, 40 * 9 + 1)
+            XCTAssertTrue(same(run[0].pt, run[run.count - 1].pt))
+        }
+    }
+
+    /// Branches, self-loops, single points and empty segments: links stay valid, and no end is left unmatched
+    /// next to an unmatched start of another segment at the same point.
+    func testBranchesAndDegenerateSegments() {
+        var rng = SeededGenerator(seed: 212)
+        for round in 0..<30 {
+            var segments = self.segments(trips: 3, perTrip: 30, length: 5, seed: 300 + UInt64(round))
+            let joints = segments.map { $0[0].pt }
+            for _ in 0..<Int.random(in: 1...20, using: &rng) {
+                let from = joints.randomElement(using: &rng)!
+                let to = Bool.random(using: &rng) ? joints.randomElement(using: &rng)! : GLMapPoint(x: from.x + 1, y: from.y)
+                switch Int.random(in: 0..<4, using: &rng) {
+                case 0: segments.append([])
+                case 1: segments.append([GLTrackPoint(pt: from, color: color)])
+                case 2: segments.append([GLTrackPoint(pt: from, color: color), GLTrackPoint(pt: from, color: color)])
+                default: segments.append([GLTrackPoint(pt: from, color: color), GLTrackPoint(pt: to, color: color)])
+                }
+            }
+            segments.shuffle(using: &rng)
+
+            let chains = TrackSegmentMerger.chains(segments, parallel: false)
+            XCTAssertEqual(TrackSegmentMerger.chains(segments, parallel: true), chains, "round \(round)")
+            assertValid(chains, segments)
+
+            var next = [Int](repeating: -1, count: segments.count)
+            var prev = [Int](repeating: -1, count: segments.count)
+            for chain in chains {
+                for (a, b) in zip(chain, chain.dropFirst()) {
+                    next[a] = b
+                    prev[b] = a
+                }
+                // A closed loop: its closing link is not repeated in the chain.
+                if chain.count > 1, same(segments[chain.last!].last!.pt, segments[chain[0]].first!.pt) {
+                    next[chain.last!] = chain[0]
+                    prev[chain[0]] = chain.last!
+                }
+            }
+            for e in segments.indices where next[e] < 0 && !segments[e].isEmpty {
+                for s in segments.indices where s != e && prev[s] < 0 && !segments[s].isEmpty {
+                    XCTAssertFalse(same(segments[e].last!.pt, segments[s].first!.pt), "round \(round): \(e) and \(s)")
+                }
+            }
+        }
+    }
+
+    func testEmptyInput() {
+        XCTAssertTrue(TrackSegmentMerger.chains([]).isEmpty)
+        XCTAssertTrue(TrackSegmentMerger.merge([]).isEmpty)
+        XCTAssertEqual(TrackSegmentMerger.merge([[GLTrackPoint(pt: GLMapPoint(x: 1, y: 2), color: color)]]).map { $0.count }, [1])
+    }
+
+    // MARK: Benchmarks, 50k segments of 100 points: a day of recording from 50 trips
+
+    private lazy var day = segments(trips: 50, perTrip: 1_000, length: 100, seed: 213)
+
+    func testChainsSerialPerformance() {
+        let segments = day
+        measure {
+            XCTAssertEqual(TrackSegmentMerger.chains(segments, parallel: false).count, 50)
+        }
+    }
+
+    func testChainsParallelPerformance() {
+        let segments = day
+        measure {
+            XCTAssertEqual(TrackSegmentMerger.chains(segments, parallel: true).count, 50)
+        }
+    }
+
+    func testMergeSerialPerformance() {
+        let segments = day
+        measure {
+            XCTAssertEqual(TrackSegmentMerger.merge(segments, parallel: false).count, 50)
+        }
+    }
+
+    func testMergeParallelPerformance() {
+        let segments = day
+        measure {
+            XCTAssertEqual(TrackSegmentMerger.merge(segments, parallel: true).count, 50)
+        }
+    }
+}
@@ -0,0 +1,244 @@
+//
+//  TrackStatsTests.swift
+//  TestWorkTests
+//
+//  Created by Илья Холопов on 17.10.2026.
+//
+
+import XCTest
+import GLMap
+@testable import TestWork
+
+final class TrackStatsTests: XCTestCase {
+    private static func terrain(_ g: GLMapGeoPoint) -> Float {
+        return Float(120 + 40 * sin(g.lat * 300) + 25 * cos(g.lon * 500))
+    }
+
+    /// Rolling hills everywhere.
+    private let hills: TrackStats.ElevationLookup = { points, count, elevation in
+        for k in 0..<count {
+            elevation[k] = TrackStatsTests.terrain(points[k])
+        }
+    }
+
+    /// Hills east of 13.40, no data or the framework's missing-data value to the west.
+    private let patchyHills: TrackStats.ElevationLookup = { points, count, elevation in
+        for k in 0..<count {
+            let g = points[k]
+            elevation[k] = g.lon >= 13.40 ? TrackStatsTests.terrain(g) : (g.lat > 52.52 ? .nan : Float(Int16.min))
+        }
+    }
+
+    /// A walk at about 1 Hz with stops, pauses between sessions and fixes sharing a timestamp.
+    private func track(_ count: Int, seed: UInt64) -> TimedTrack {
+        var rng = SeededGenerator(seed: seed)
+        var t = 1_790_000_000.0
+        let points = TestData.walk(count, seed: seed).map { GLTrackPoint(pt: $0, color: .black) }
+        var standing = false
+        let times = (0..<count).map { _ -> TimeInterval in
+            switch Int.random(in: 0..<100, using: &rng) {
+            case 0: t += Double.random(in: 60...3_600, using: &rng)
+            case 1...3: break
+            case 4: standing.toggle()
+            default: t += standing ? Double.random(in: 20...40, using: &rng) : Double.random(in: 0.5...1.5, using: &rng)
+            }
+            return t
+        }
+        return TimedTrack(points: points, times: times)
+    }
+
+    /// Time-weighted percentile, straight from the definition.
+    private func percentile(_ samples: [(v: Double, w: Double)], _ p: Double) -> Double {
+        let sorted = samples.sorted { $0.v < $1.v }
+        let total = samples.reduce(0) { $0 + $1.w }
+        var sum = 0.0
+        for s in sorted {
+            sum += s.w
+            if sum >= p * total {
+                return s.v
+            }
+        }
+        return sorted.last?.v ?? 0
+    }
+
+    private func elevation(_ p: GLMapPoint, _ lookup: TrackStats.ElevationLookup) -> Float {
+        var g = [GeoBatch.geoPoint(from: p)]
+        var e: [Float] = [.nan]
+        lookup(&g, 1, &e)
+        return e[0]
+    }
+
+    /// Each metric from its own pass, straight from its definition.
+    private func assertMatchesSeparatePasses(_ track: TimedTrack, _ range: Range<Int>, spacing: Double,
+                                             _ lookup: TrackStats.ElevationLookup, file: StaticString = #filePath, line: UInt = #line) {
+        let stats = TrackStats(track: track, range: range, profileSpacing: spacing, elevations: lookup)
+        let d = track.distances, t = track.times
+        XCTAssertEqual(stats.length, d[range.last!] - d[range.first!], accuracy: 1e-6, file: file, line: line)
+        XCTAssertEqual(stats.duration, t[range.last!] - t[range.first!], file: file, line: line)
+
+        let samples = range.dropFirst().compactMap { i -> (v: Double, w: Double)? in
+            let dt = t[i] - t[i - 1]
+            return dt > 0 ? ((d[i] - d[i - 1]) / dt, dt) : nil
+        }
+        XCTAssertEqual(stats.movingDuration, samples.filter { $0.v >= TrackStats.movingSpeed }.reduce(0) { $0 + $1.w },
+                       accuracy: 1e-6, file: file, line: line)
+        XCTAssertEqual(stats.maxSpeed, samples.map { $0.v }.max() ?? 0, file: file, line: line)
+        XCTAssertEqual(stats.medianSpeed, percentile(samples, 0.5), file: file, line: line)
+        XCTAssertEqual(stats.p90Speed, percentile(samples, 0.9), file: file, line: line)
+
+        // Climbing with the dead band.
+        var reference: Float?
+        var ascent = 0.0, descent = 0.0
+        for i in range {
+            let e = elevation(track.points[i].pt, lookup)
+            guard e.isFinite && e > Float(Int16.min) else { continue }
+            guard let r = reference else {
+                reference = e
+                continue
+            }
+            if e - r >= TrackStats.climbThreshold {
+                ascent += Double(e - r)
+                reference = e
+            } else if r - e >= TrackStats.climbThreshold {
+                descent += Double(r - e)
+                reference = e
+            }
+        }
+        XCTAssertEqual(stats.ascent == nil, reference == nil, file: file, line: line)
+        XCTAssertEqual(stats.ascent ?? 0, ascent, accuracy: 1e-3, file: file, line: line)
+        XCTAssertEqual(stats.descent ?? 0, descent, accuracy: 1e-3, file: file, line: line)
+
+        // Profile marks every `spacing` meters, at the point that far along the track.
+        var expected: [TrackStats.ProfileSample] = []
+        var i = range.lowerBound
+        var target = d[range.lowerBound]
+        while spacing > 0 && target <= d[range.last!] {
+            while d[i] < target {
+                i += 1
+            }
+            var p = track.points[i].pt
+            if i > range.lowerBound && d[i] > d[i - 1] {
+                let a = track.points[i - 1].pt, f = (target - d[i - 1]) / (d[i] - d[i - 1])
+                p = GLMapPoint(x: a.x + (p.x - a.x) * f, y: a.y + (p.y - a.y) * f)
+            }
+            let e = elevation(p, lookup)
+            if e.isFinite && e > Float(Int16.min) {
+                expected.append(TrackStats.ProfileSample(distance: target - d[range.lowerBound], elevation: e))
+            }
+            target += spacing
+        }
+        XCTAssertEqual(stats.profile.count, expected.count, file: file, line: line)
+        for (s, e) in zip(stats.profile, expected) {
+            XCTAssertEqual(s.distance, e.distance, accuracy: 1e-6, file: file, line: line)
+            XCTAssertEqual(s.elevation, e.elevation, accuracy: 0.01, file: file, line: line)
+        }
+    }
+
+    func testWholeTrackMatchesSeparatePasses() {
+        // Longer than a lookup chunk, so chunk and mark batch boundaries are crossed.
+        let track = self.track(20_000, seed: 230)
+        assertMatchesSeparatePasses(track, 0..<track.count, spacing: 100, hills)
+        assertMatchesSeparatePasses(track, 0..<track.count, spacing: 7, hills)
+        assertMatchesSeparatePasses(track, 0..<track.count, spacing: 0, hills)
+    }
+
+    func testRangesMatchSeparatePasses() {
+        let track = self.track(10_000, seed: 231)
+        var rng = SeededGenerator(seed: 232)
+        for _ in 0..<20 {
+            let a = Int.random(in: 0..<track.count, using: &rng)
+            let b = Int.random(in: (a + 1)...min(track.count, a + 6_000), using: &rng)
+            assertMatchesSeparatePasses(track, a..<b, spacing: 50, hills)
+        }
+        let slice = track.slice(from: track.times[1_000], to: track.times[4_000])
+        XCTAssertEqual(slice.stats().length, TrackStats(track: track, range: slice.range).length)
+    }
+
+    func testMissingElevationData() {
+        // The walk starts on the edge of the data, so it runs in and out of it.
+        let track = self.track(10_000, seed: 233)
+        assertMatchesSeparatePasses(track, 0..<track.count, spacing: 100, patchyHills)
+        let none = TrackStats(track: track, elevations: { _, count, elevation in
+            for k in 0..<count {
+                elevation[k] = .nan
+            }
+        })
+        XCTAssertNil(none.ascent)
+        XCTAssertNil(none.descent)
+        XCTAssertTrue(none.profile.isEmpty)
+        XCTAssertEqual(none.length, track.distances[track.count - 1], accuracy: 1e-6)
+    }
+
+    func testDegenerateTracks() {
+        let empty = TrackStats(track: TimedTrack(), elevations: hills)
+        XCTAssertEqual(empty.length, 0)
+        XCTAssertEqual(empty.duration, 0)
+        XCTAssertEqual(empty.medianSpeed, 0)
+        XCTAssertNil(empty.ascent)
+        XCTAssertTrue(empty.profile.isEmpty)
+
+        // All fixes at one time: no speeds, but a length.
+        let point = GLTrackPoint(pt: GLMapPoint(x: 0, y: 0), color: .black)
+        let moved = GLTrackPoint(pt: GLMapPoint(x: 1e4, y: 0), color: .black)
+        let burst = TrackStats(track: TimedTrack(points: [point, moved, point], times: [5, 5, 5]), elevations: hills)
+        XCTAssertGreaterThan(burst.length, 0)
+        XCTAssertEqual(burst.duration, 0)
+        XCTAssertEqual(burst.maxSpeed, 0)
+        XCTAssertEqual(burst.movingDuration, 0)
+    }
+
+    func testStatsAreRecomputedAfterAppend() {
+        let track = self.track(1_000, seed: 234)
+        let before = track.stats()
+        XCTAssertEqual(track.stats().length, before.length)
+        track.append(GLTrackPoint(pt: GLMapPoint(x: track.points[999].pt.x + 1e4, y: track.points[999].pt.y), color: .black),
+                     time: track.endTime! + 60)
+        XCTAssertGreaterThan(track.stats().length, before.length)
+        XCTAssertEqual(track.stats().duration, before.duration + 60, accuracy: 1e-6)
+    }
+
+    // MARK: Benchmarks, a million-point track
+
+    private lazy var million = track(1_000_000, seed: 235)
+
+    func testStatsPerformance() {
+        let track = million
+        measure {
+            let stats = TrackStats(track: track, profileSpacing: 100, elevations: hills)
+            XCTAssertNotNil(stats.ascent)
+            XCTAssertGreaterThan(stats.profile.count, 0)
+        }
+    }
+
+    /// The same pass against the downloaded elevation data, whatever the test device has.
+    func testStatsWithDownloadedElevationPerformance() {
+        let track = million
+        measure {
+            XCTAssertGreaterThan(TrackStats(track: track, profileSpacing: 100).length, 0)
+        }
+    }
+
+    /// Baseline: one elevation lookup per point, on a tenth of the track.
+    func testPerPointElevationLookupPerformance() {
+        let points = million.points.prefix(100_000).map { $0.pt }
+        measure {
+            var g = [GLMapGeoPoint(lat: 0, lon: 0)]
+            var e: [Float] = [.nan]
+            var valid = 0
+            for p in points {
+                g[0] = GLMapGeoPoint(point: p)
+                TrackStats.downloadedElevations(&g, 1, &e)
+                valid += e[0].isFinite ? 1 : 0
+            }
+            XCTAssertLessThanOrEqual(valid, points.count)
+        }
+    }
+
+    /// Baseline: the framework's length alone on the same points.
+    func testFrameworkLengthPerformance() {
+        let data = million.points.withUnsafeBufferPointer { GLMapTrackData(points: $0.baseAddress!, count: UInt($0.count)) }!
+        measure {
+            XCTAssertGreaterThan(data.calculateLength(), 0)
+        }
+    }
+}